@@ -67,6 +67,20 @@ bool AudioFile::open(const QByteArray& b)
       return sf != 0;
       }
 
+//---------------------------------------------------------
+//   open
+//    open a file on disk, the data are read on demand
+//---------------------------------------------------------
+
+bool AudioFile::open(const QString& path)
+      {
+      sf = sf_open(qPrintable(path), SFM_READ, &info);
+      if (!sf)
+            return false;
+      hasInstrument = sf_command(sf, SFC_GET_INSTRUMENT, &inst, sizeof(inst)) == SF_TRUE;
+      return true;
+      }
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -145,7 +145,7 @@ int Voice::dsp_float_interpolate_none(unsigned n)
 
       Phase dsp_phase = voice->phase;
       Phase dsp_phase_incr; //  end_phase;
-      short int *dsp_data = voice->sample->data;
+      const short int* dsp_data = voice->sample->data;
       float *dsp_buf = voice->dsp_buf;
       auto curSample2AmpInc = Sample2AmpInc.begin();
       qreal dsp_amp_incr = curSample2AmpInc->second;
@@ -211,7 +211,7 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
       Voice* voice = this;
       Phase dsp_phase = voice->phase;
       Phase dsp_phase_incr; // end_phase;
-      short int *dsp_data = voice->sample->data;
+      const short int* dsp_data = voice->sample->data;
       float *dsp_buf = voice->dsp_buf;
       auto curSample2AmpInc = Sample2AmpInc.begin();
       qreal dsp_amp_incr = curSample2AmpInc->second;
@@ -306,7 +306,7 @@ int Voice::dsp_float_interpolate_linear(unsigned n)
 int Voice::dsp_float_interpolate_4th_order(unsigned n)
       {
       Phase dsp_phase_incr; // end_phase;
-      short int* dsp_data = sample->data;
+      const short int* dsp_data = sample->data;
       auto curSample2AmpInc = Sample2AmpInc.begin();
       qreal dsp_amp_incr = curSample2AmpInc->second;
       unsigned int nextNewAmpInc = curSample2AmpInc->first;
@@ -454,7 +454,7 @@ int Voice::dsp_float_interpolate_7th_order(unsigned n)
 
       Phase dsp_phase = voice->phase;
       Phase dsp_phase_incr; // end_phase;
-      short int *dsp_data = voice->sample->data;
+      const short int* dsp_data = voice->sample->data;
       float *dsp_buf = voice->dsp_buf;
       auto curSample2AmpInc = Sample2AmpInc.begin();
       qreal dsp_amp_incr = curSample2AmpInc->second;
@@ -72,6 +72,7 @@ static const Mod forcePanMod = { GEN_PAN, 10, FLUID_MOD_CC | FLUID_MOD_LINEAR |
 Fluid::Fluid()
    : Synthesizer()
       {
+      _partitioned = false;
       }
 
 //---------------------------------------------------------
@@ -120,6 +121,8 @@ Fluid::~Fluid()
 
 void Fluid::freeVoice(Voice* v)
       {
+      if (_partitioned)
+            return;
       if (activeVoices.removeOne(v))
             freeVoices.append(v);
       }
@@ -399,6 +402,72 @@ void Fluid::process(unsigned len, float* out, float* effect1, float* effect2)
             }
       }
 
+//---------------------------------------------------------
+//   processChannels
+//    only used for offline export, so wait for the lock
+//    instead of skipping the block like process()
+//---------------------------------------------------------
+
+bool Fluid::processChannels(unsigned len, float** bus, int channels, float* effect1, float* effect2)
+      {
+      mutex.lock();
+      foreach (Voice* v, activeVoices) {
+            int ch = v->get_channel()->getNum();
+            if (ch < channels)
+                  v->write(len, bus[ch], effect1, effect2);
+            }
+      mutex.unlock();
+      return true;
+      }
+
+//---------------------------------------------------------
+//   beginPartitions
+//    the mutex is held until endPartitions()
+//---------------------------------------------------------
+
+bool Fluid::beginPartitions()
+      {
+      if (!mutex.tryLock())
+            return false;
+      if (activeVoices.isEmpty()) {
+            mutex.unlock();
+            return false;
+            }
+      _partitioned = true;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   processPartition
+//    render every parts'th voice; voices which finish are
+//    not removed from activeVoices until endPartitions()
+//---------------------------------------------------------
+
+void Fluid::processPartition(int part, int parts, unsigned len, float* out, float* effect1, float* effect2)
+      {
+      for (int i = part; i < activeVoices.size(); i += parts)
+            activeVoices.at(i)->write(len, out, effect1, effect2);
+      }
+
+//---------------------------------------------------------
+//   endPartitions
+//---------------------------------------------------------
+
+void Fluid::endPartitions()
+      {
+      _partitioned = false;
+      for (int i = 0; i < activeVoices.size();) {
+            Voice* v = activeVoices.at(i);
+            if (v->status == FLUID_VOICE_OFF && v->RELEASED()) {
+                  activeVoices.removeAt(i);
+                  freeVoices.append(v);
+                  }
+            else
+                  ++i;
+            }
+      mutex.unlock();
+      }
+
 /*
  * fluid_synth_free_voice_by_kill
  *
@@ -309,6 +309,7 @@ class Fluid : public Synthesizer {
       double _tuning[128];                // the pitch of every key, in cents
 
       QMutex mutex;
+      bool _partitioned;                  // rendering in partitions, voices are freed by endPartitions()
       void updatePatchList();
 
    protected:
@@ -378,6 +379,10 @@ class Fluid : public Synthesizer {
       void free_voice_by_kill();
 
       virtual void process(unsigned len, float* out, float* effect1, float* effect2);
+      virtual bool beginPartitions();
+      virtual void processPartition(int part, int parts, unsigned len, float* out, float* effect1, float* effect2);
+      virtual void endPartitions();
+      virtual bool processChannels(unsigned len, float** bus, int channels, float* effect1, float* effect2);
 
       bool program_select(int chan, unsigned sfont_id, unsigned bank_num, unsigned preset_num);
       void get_program(int chan, unsigned* sfont_id, unsigned* bank_num, unsigned* preset_num);
@@ -21,6 +21,9 @@
  * 02111-1307, USA
  */
 
+#include <QCryptographicHash>
+#include <QStandardPaths>
+
 #include "sfont.h"
 #include "fluid.h"
 #include "voice.h"
@@ -53,6 +56,8 @@ SFont::SFont(Fluid* f)
       samplepos   = 0;
       samplesize  = 0;
       _bankOffset = 0;
+      sampleMap   = 0;
+      sampleMapFailed = false;
       }
 
 SFont::~SFont()
@@ -92,6 +97,55 @@ bool SFont::read(const QString& s)
       return true;
       }
 
+//---------------------------------------------------------
+//   sampleData
+//    Map the sample chunk of the file read only. The pages
+//    are shared by all processes using the font. Returns 0
+//    if the file cannot be mapped; the data are in little
+//    endian byte order.
+//---------------------------------------------------------
+
+const short* SFont::sampleData()
+      {
+      if (!sampleMap && !sampleMapFailed) {
+            mapFile.setFileName(f.fileName());
+            if (mapFile.open(QIODevice::ReadOnly)) {
+                  sampleMap = mapFile.map(samplepos, samplesize);
+                  mapFile.close();        // the mapping stays valid
+                  }
+            if (sampleMap && (quintptr(sampleMap) & 1)) {
+                  mapFile.unmap(const_cast<uchar*>(sampleMap));
+                  sampleMap = 0;
+                  }
+            sampleMapFailed = sampleMap == 0;
+            }
+      return reinterpret_cast<const short*>(sampleMap);
+      }
+
+//---------------------------------------------------------
+//   sampleCachePath
+//    Decompressed SF3 samples are cached on disk. The
+//    cache is keyed by the checksum of the font file and
+//    the position of the compressed sample in it.
+//---------------------------------------------------------
+
+QString SFont::sampleCachePath(unsigned offset)
+      {
+      if (_fontHash.isEmpty()) {
+            QFile file(f.fileName());
+            if (!file.open(QIODevice::ReadOnly))
+                  return QString();
+            QCryptographicHash hash(QCryptographicHash::Md5);
+            if (!hash.addData(&file))
+                  return QString();
+            _fontHash = hash.result().toHex();
+            }
+      QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+      if (dir.isEmpty())
+            return QString();
+      return QString("%1/soundfonts/%2/%3.pcm").arg(dir).arg(QString(_fontHash)).arg(offset);
+      }
+
 //---------------------------------------------------------
 //   get_preset
 //---------------------------------------------------------
@@ -586,6 +640,8 @@ Sample::Sample(SFont* s)
       pitchadj    = 0;
       sampletype  = 0;
       data        = 0;
+      _buffer     = 0;
+      _cacheFile  = 0;
       amplitude_that_reaches_noise_floor_is_valid = false;
       amplitude_that_reaches_noise_floor = 0.0;
       }
@@ -596,7 +652,8 @@ Sample::Sample(SFont* s)
 
 Sample::~Sample()
       {
-      delete[] data;
+      delete[] _buffer;
+      delete _cacheFile;
       }
 
 //---------------------------------------------------------
@@ -607,6 +664,30 @@ void Sample::load()
       {
       if (!_valid || data)
             return;
+#ifdef SOUNDFONT3
+      // a decompressed sample may be in the cache already
+      QString cache;
+      if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
+            cache = sf->sampleCachePath(start);
+            if (!cache.isEmpty() && readCache(cache)) {
+                  optimize();
+                  return;
+                  }
+            }
+#endif
+      if (!(sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) && QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
+            // use the sample data in place
+            const short* map = sf->sampleData();
+            if (map && end * sizeof(short) <= sf->getSamplesize()) {
+                  data       = map + start;
+                  end       -= (start + 1);
+                  loopstart -= start;
+                  loopend   -= start;
+                  start      = 0;
+                  optimize();
+                  return;
+                  }
+            }
       QFile fd(sf->get_name());
       if (!fd.open(QIODevice::ReadOnly))
             return;
@@ -630,25 +711,28 @@ void Sample::load()
                   }
             decompressOggVorbis(p, size);
             delete[] p;
+            if (!cache.isEmpty())
+                  writeCache(cache);
 #endif
             }
       else {
-            data = new short[size];
+            _buffer = new short[size];
+            data    = _buffer;
             size *= sizeof(short);
 
-            if (fd.read((char*)data, size) != size)
+            if (fd.read((char*)_buffer, size) != size)
                   return;
 
             if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
                   unsigned char hi, lo;
                   unsigned int i, j;
                   short s;
-                  uchar* cbuf = (uchar*) data;
+                  uchar* cbuf = (uchar*) _buffer;
                   for (i = 0, j = 0; j < size; i++) {
                         lo = cbuf[j++];
                         hi = cbuf[j++];
                         s = (hi << 8) | lo;
-                        data[i] = s;
+                        _buffer[i] = s;
                         }
                   }
             end       -= (start + 1);       // marks last sample, contrary to SF spec.
@@ -66,6 +66,11 @@ class SFont {
       SFVersion romver;		      // ROM version
       QList<unsigned char*> infos;	// list of info strings (1st byte is ID)
 
+      QFile mapFile;                // read only mapping of the sample data
+      const uchar* sampleMap;
+      bool sampleMapFailed;
+      QByteArray _fontHash;
+
       void read_listchunk(SFChunk* chunk);
       void process_info(int size);
       void process_sdta(unsigned int size);
@@ -109,6 +114,8 @@ class SFont {
       bool read(const QString& file);
 
       int load_sampledata();
+      const short* sampleData();
+      QString sampleCachePath(unsigned offset);
       unsigned int samplePos() const            { return samplepos;  }
       int id() const                            { return _id; }
       void setId(int i)                         { _id = i;    }
@@ -128,6 +135,12 @@ class SFont {
 
 class Sample {
       bool _valid;
+      short* _buffer;         // data allocated by the sample
+      QFile* _cacheFile;      // mapped decompressed SF3 sample
+#ifdef SOUNDFONT3
+      bool readCache(const QString& path);
+      void writeCache(const QString& path);
+#endif
 
    public:
       SFont* sf;
@@ -140,7 +153,7 @@ class Sample {
       int pitchadj;
       int sampletype;
 
-      short* data;
+      const short* data;      // heap, mapped sf2 file or mapped sf3 cache
 
       /** The amplitude, that will lower the level of the sample's loop to
           the noise floor. Needed for note turnoff optimization, will be
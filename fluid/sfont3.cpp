@@ -1,6 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
 #include "sfont.h"
 #include "audiofile/audiofile.h"
 
@@ -22,12 +28,13 @@ bool Sample::decompressOggVorbis(char* src, int size)
             return false;
             }
       int frames = af.frames();
-      data = new short[frames * af.channels()];
-      if (frames != af.read(data, frames)) {
+      _buffer = new short[frames * af.channels()];
+      if (frames != af.read(_buffer, frames)) {
             qDebug("Sample read failed: %s", af.error());
-            delete[] data;
-            data = 0;
+            delete[] _buffer;
+            _buffer = 0;
             }
+      data = _buffer;
       end = frames - 1;
 
       if (loopend > end ||loopstart >= loopend || loopstart <= start) {
@@ -48,4 +55,92 @@ bool Sample::decompressOggVorbis(char* src, int size)
 
       return true;
       }
+
+//---------------------------------------------------------
+//   CacheHeader
+//    header of a decompressed sample in the cache,
+//    followed by the sample data
+//---------------------------------------------------------
+
+struct CacheHeader {
+      char magic[4];
+      quint32 version;
+      quint32 end;
+      quint32 loopstart;
+      quint32 loopend;
+      quint32 valid;
+      };
+
+static const char cacheMagic[4] = { 'S', 'F', '3', 'C' };
+static const quint32 cacheVersion = 1;
+
+//---------------------------------------------------------
+//   readCache
+//    map a decompressed sample from the cache; the pages
+//    are shared with all other processes using the font
+//---------------------------------------------------------
+
+bool Sample::readCache(const QString& path)
+      {
+      QFile* file = new QFile(path);
+      if (!file->open(QIODevice::ReadOnly)) {
+            delete file;
+            return false;
+            }
+      qint64 size = file->size();
+      const uchar* p = size >= qint64(sizeof(CacheHeader)) ? file->map(0, size) : 0;
+      file->close();          // the mapping stays valid
+      if (!p) {
+            delete file;
+            return false;
+            }
+      const CacheHeader* h = reinterpret_cast<const CacheHeader*>(p);
+      if (memcmp(h->magic, cacheMagic, 4) || h->version != cacheVersion
+         || size != qint64(sizeof(CacheHeader) + (qint64(h->end) + 1) * sizeof(short))) {
+            qDebug("Sample::readCache: invalid cache file <%s>", qPrintable(path));
+            delete file;
+            return false;
+            }
+      delete[] _buffer;
+      _buffer = 0;
+      delete _cacheFile;
+      _cacheFile = file;
+      data       = reinterpret_cast<const short*>(p + sizeof(CacheHeader));
+      start      = 0;
+      end        = h->end;
+      loopstart  = h->loopstart;
+      loopend    = h->loopend;
+      setValid(h->valid);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   writeCache
+//    store the decompressed sample and replace the heap
+//    copy by a mapping of the cache file
+//---------------------------------------------------------
+
+void Sample::writeCache(const QString& path)
+      {
+      if (!_buffer)
+            return;
+      QDir().mkpath(QFileInfo(path).absolutePath());
+      QSaveFile file(path);
+      if (!file.open(QIODevice::WriteOnly))
+            return;
+      CacheHeader h;
+      memcpy(h.magic, cacheMagic, 4);
+      h.version   = cacheVersion;
+      h.end       = end;
+      h.loopstart = loopstart;
+      h.loopend   = loopend;
+      h.valid     = valid();
+      file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+      file.write(reinterpret_cast<const char*>(_buffer), (qint64(end) + 1) * sizeof(short));
+      if (!file.commit()) {
+            qDebug("Sample::writeCache: cannot write <%s>", qPrintable(path));
+            return;
+            }
+      readCache(path);
+      }
 } // namespace
@@ -166,7 +166,7 @@ void Bend::draw(QPainter* painter) const
 
       qreal _spatium = spatium();
       const TextStyle* st = &score()->textStyle(TextStyleType::BEND);
-      QFont f = st->font(_spatium * MScore::pixelRatio);
+      QFont f = st->font(_spatium * MScore::pixelRatio());
       painter->setFont(f);
 
       int n    = _points.size();
@@ -88,6 +88,36 @@ void CmdState::reset()
       _updateMode         = UpdateMode::DoNothing;
       _startTick          = -1;
       _endTick            = -1;
+      _playStartTick      = -1;
+      _playEndTick        = -1;
+      _renderChanged      = false;
+      }
+
+//---------------------------------------------------------
+//   restoreLayout
+//    restore the update mode and the layout range of cs,
+//    keep the play range and the render flag
+//---------------------------------------------------------
+
+void CmdState::restoreLayout(const CmdState& cs)
+      {
+      _updateMode = cs._updateMode;
+      _startTick  = cs._startTick;
+      _endTick    = cs._endTick;
+      }
+
+//---------------------------------------------------------
+//   rangeOnly
+//    true if the changes are limited to the layout range
+//    or only changed play events and rendering; then not
+//    all play events have to be rendered again
+//---------------------------------------------------------
+
+bool CmdState::rangeOnly() const
+      {
+      if (layoutRange())
+            return true;
+      return (playRange() || _renderChanged) && !layoutAll() && !updateAll();
       }
 
 //---------------------------------------------------------
@@ -105,6 +135,19 @@ void CmdState::setTick(int t)
       setUpdateMode(UpdateMode::LayoutRange);
       }
 
+//---------------------------------------------------------
+//   setPlayTick
+//    the play events at tick t changed, the layout did not
+//---------------------------------------------------------
+
+void CmdState::setPlayTick(int t)
+      {
+      if (_playStartTick == -1 || t < _playStartTick)
+            _playStartTick = t;
+      if (_playEndTick == -1 || t > _playEndTick)
+            _playEndTick = t;
+      }
+
 //---------------------------------------------------------
 //   setUpdateMode
 //---------------------------------------------------------
@@ -150,6 +193,10 @@ void Score::undoRedo(bool undo)
             undoStack()->undo();
       else
             undoStack()->redo();
+      if (!cmdState().rangeOnly()) {
+            for (Score* s : scoreList())
+                  s->setPlayAllDirty();
+            }
       update();
       updateSelection();
       }
@@ -171,6 +218,7 @@ void Score::endCmd(bool rollback)
       if (rollback)
             undoStack()->current()->unwind();
 
+      bool rangeOnly = cmdState().rangeOnly();
       update();
 
       if (MScore::debugMode)
@@ -181,6 +229,11 @@ void Score::endCmd(bool rollback)
       if (dirty()) {
             masterScore()->_playlistDirty = true;  // TODO: flag individual operations
             masterScore()->_autosaveDirty = true;
+            // changes without a layout or play range may affect any measure
+            if (!rangeOnly) {
+                  for (Score* s : scoreList())
+                        s->setPlayAllDirty();
+                  }
             }
       MuseScoreCore::mscoreCore->endCmd();
       cmdState().reset();
@@ -195,17 +248,27 @@ void Score::update()
       {
       CmdState& cs = cmdState();
       if (cs.layoutAll()) {
-            for (Score* s : scoreList())
+            for (Score* s : scoreList()) {
+                  s->setPlayAllDirty();
                   s->doLayout();
+                  }
             cs._setUpdateMode(UpdateMode::UpdateAll);
             }
       else if (cs.layoutRange()) {
-            for (Score* s : scoreList())
+            for (Score* s : scoreList()) {
+                  s->setPlayRangeDirty(cs.startTick(), cs.endTick());
                   s->doLayoutRange(cs.startTick(), cs.endTick());
+                  }
             cs._setUpdateMode(UpdateMode::UpdateAll);
             }
+      if (cs.playRange()) {
+            for (Score* s : scoreList())
+                  s->setPlayRangeDirty(cs.playStartTick(), cs.playEndTick());
+            }
       if (cs.updateAll()) {
             for (Score* s : scoreList()) {
+                  for (Page* page : s->pages())
+                        page->invalidateDisplayList();
                   for (MuseScoreView* v : s->viewer)
                         v->updateAll();
                   }
@@ -215,6 +278,13 @@ void Score::update()
             // updateRange updates only current score
             qreal d = spatium() * .5;
             _updateState.refresh.adjust(-d, -d, 2 * d, 2 * d);
+            // elements may have moved without a layout (edit drags)
+            // (the page bbox does not cover a continuous view)
+            bool pageMode = layoutMode() == LayoutMode::PAGE || layoutMode() == LayoutMode::FLOAT;
+            for (Page* page : pages()) {
+                  if (!pageMode || page->canvasBoundingRect().intersects(_updateState.refresh))
+                        page->invalidateDisplayList();
+                  }
             for (MuseScoreView* v : viewer)
                   v->dataChanged(_updateState.refresh);
             _updateState.refresh = QRectF();
@@ -278,7 +278,6 @@ Element::Element(Score* s) :
       _color         = MScore::defaultColor;
       _mag           = 1.0;
       _tag           = 1;
-      itemDiscovered = false;
       _z             = -1;
       }
 
@@ -297,7 +296,6 @@ Element::Element(const Element& e)
       _readPos    = e._readPos;
       _bbox       = e._bbox;
       _tag        = e._tag;
-      itemDiscovered = false;
       }
 
 //---------------------------------------------------------
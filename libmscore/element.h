@@ -576,8 +576,6 @@ class Element : public QObject, public ScoreElement {
  */
       virtual bool mousePress(const QPointF&, QMouseEvent*) { return false; }
 
-      mutable bool itemDiscovered;     ///< helper flag for bsp
-
       virtual void scanElements(void* data, void (*func)(void*, Element*), bool all=true);
 
       virtual void reset();         // reset all properties & position to default
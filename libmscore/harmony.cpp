@@ -1174,7 +1174,7 @@ void Harmony::draw(QPainter* painter) const
       painter->setPen(color);
       foreach(const TextSegment* ts, textList) {
             QFont f(ts->font);
-            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
             painter->setFont(f);
             painter->drawText(QPointF(ts->x, ts->y), ts->text);
             }
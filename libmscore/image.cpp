@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QThread>
+
 #include "image.h"
 #include "xml.h"
 #include "score.h"
@@ -238,6 +240,18 @@ QVariant Image::propertyDefault(P_ID id) const
       return QVariant();
       }
 
+//---------------------------------------------------------
+//   onGuiThread
+//    QPixmap can only be used on the gui thread; pages
+//    rendered by worker threads draw the QImage directly
+//---------------------------------------------------------
+
+static bool onGuiThread()
+      {
+      QCoreApplication* app = QCoreApplication::instance();
+      return app && QThread::currentThread() == app->thread();
+      }
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
@@ -264,7 +278,21 @@ void Image::draw(QPainter* painter) const
                   if (score()->printing()) {
                         // use original image size for printing
                         painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        if (onGuiThread())
+                              painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        else
+                              painter->drawImage(QPointF(0, 0), *rasterDoc);
+                        }
+                  else if (!onGuiThread()) {
+                        // no cached pixmap outside of the gui thread
+                        QTransform t = painter->transform();
+                        QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
+                        t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
+                        painter->setWorldTransform(t);
+                        if (rasterDoc->isNull() || ss.isEmpty())
+                              emptyImage = true;
+                        else
+                              painter->drawImage(QPointF(0.0, 0.0), rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
                         }
                   else {
                         QTransform t = painter->transform();
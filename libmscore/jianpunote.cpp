@@ -214,7 +214,7 @@ void JianpuNote::draw(QPainter* painter) const
       QString txt = QString::number(_noteNumber);
       StaffType* st = staff()->staffType();
       QFont f(st->jianpuNoteFont());
-      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
       painter->setFont(f);
       painter->setPen(QColor(curColor()));
       // We take bounding box y-position as top of the note number.
@@ -122,7 +122,7 @@ void JianpuRest::draw(QPainter* painter) const
       // Draw the rest number "0".
       StaffType* st = staff()->staffType();
       QFont f(st->jianpuNoteFont());
-      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
       painter->setFont(f);
       painter->setPen(QColor(curColor()));
       // We take bounding box y-position as top of the note number.
@@ -1757,13 +1757,33 @@ System* Score::getNextSystem(LayoutContext& lc)
       {
       bool isVBox = lc.curMeasure->isVBox();
       System* system;
-      if (lc.systemList.empty()) {
-            system = new System(this);
+      if (lc.rangeLayout) {
+            // In a range layout the old system is only reused if it
+            // starts with the current measure. If the system breaks
+            // have shifted, this finds the old system again and the
+            // layout can converge (see collectSystem()). Old systems
+            // whose first measure was already collected are obsolete.
+            while (!lc.systemList.empty()) {
+                  System* s = lc.systemList.front();
+                  if (!s->measures().empty() && s->measures().front()->system() == s)
+                        break;
+                  lc.systemList.removeFirst();
+                  s->clear();
+                  _freeSystems.append(s);
+                  }
+            }
+      if (lc.systemList.empty() || (lc.rangeLayout && lc.systemList.front()->measures().front() != lc.curMeasure)) {
+            if (_freeSystems.empty())
+                  system = new System(this);
+            else
+                  system = _freeSystems.takeFirst();
             lc.systemOldMeasure = 0;
+            lc.systemOldWidth   = 0.0;
             }
       else {
             system = lc.systemList.takeFirst();
             lc.systemOldMeasure = system->measures().empty() ? 0 : system->measures().back();
+            lc.systemOldWidth   = system->width();
             system->clear();   // remove measures from system
             }
       _systems.append(system);
@@ -2354,6 +2374,92 @@ void Score::createBeams(Measure* measure)
             }
       }
 
+//---------------------------------------------------------
+//   forEachStaff
+//    call f(staffIdx) for all staves. In parallel layout
+//    mode the staves of larger scores are distributed over
+//    the global thread pool; f must then only modify
+//    elements of its own staff.
+//---------------------------------------------------------
+
+template <class F>
+static void forEachStaff(int nstaves, F f)
+      {
+      static const int PARALLEL_MIN_STAVES = 4;
+
+      if (MScore::parallelLayout && nstaves >= PARALLEL_MIN_STAVES
+         && QThreadPool::globalInstance()->maxThreadCount() > 1) {
+            QVector<int> staves(nstaves);
+            for (int i = 0; i < nstaves; ++i)
+                  staves[i] = i;
+            const RenderContext& ctx = MScore::renderContext();
+            QtConcurrent::blockingMap(staves, [&f, &ctx](int staffIdx) {
+                  RenderScope scope(ctx);
+                  f(staffIdx);
+                  });
+            }
+      else {
+            for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx)
+                  f(staffIdx);
+            }
+      }
+
+//---------------------------------------------------------
+//   collectMMRest
+//    collect the measures starting with m which can form a
+//    multi measure rest; n is set to their number and len
+//    to their total length, the last one is returned
+//---------------------------------------------------------
+
+static Measure* collectMMRest(Measure* m, bool showVBox, int& n, Fraction& len)
+      {
+      Measure* nm = m;
+      Measure* lm = nm;
+      n           = 0;
+      len         = Fraction();
+      while (validMMRestMeasure(nm)) {
+            MeasureBase* mb = showVBox ? nm->next() : nm->nextMeasure();
+            if (breakMultiMeasureRest(nm) && n)
+                  break;
+            ++n;
+            len += nm->len();
+            lm = nm;
+            if (!(mb && mb->isMeasure()))
+                  break;
+            nm = toMeasure(mb);
+            }
+      return lm;
+      }
+
+//---------------------------------------------------------
+//   createMMRests
+//    create and remove the multi measure rests as the next
+//    layout will do. This is done serially before part
+//    scores are laid out concurrently: it goes through the
+//    undo stack of the master score, and the layout then
+//    finds all multi measure rests up to date.
+//---------------------------------------------------------
+
+void Score::createMMRests()
+      {
+      if (lineMode() || !styleB(StyleIdx::createMultiMeasureRests))
+            return;
+      for (Measure* m = firstMeasure(); m;) {
+            int n;
+            Fraction len;
+            Measure* lm = collectMMRest(m, _showVBox, n, len);
+            if (n >= styleI(StyleIdx::minEmptyMeasures)) {
+                  createMMRest(m, lm, len);
+                  m = lm->nextMeasure();
+                  }
+            else {
+                  if (m->mmRest())
+                        undo(new ChangeMMRest(m, 0));
+                  m = m->nextMeasure();
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   getNextMeasure
 //---------------------------------------------------------
@@ -2383,24 +2489,15 @@ void Score::getNextMeasure(LayoutContext& lc)
       else if (lc.curMeasure->isMeasure()) {
             if (score()->styleB(StyleIdx::createMultiMeasureRests)) {
                   Measure* m = toMeasure(lc.curMeasure);
-                  Measure* nm = m;
-                  Measure* lm = nm;
-                  int n       = 0;
+                  int n;
                   Fraction len;
+                  Measure* lm = collectMMRest(m, _showVBox, n, len);
 
                   lc.measureNo = m->no();
-
-                  while (validMMRestMeasure(nm)) {
-                        MeasureBase* mb = _showVBox ? nm->next() : nm->nextMeasure();
-                        if (breakMultiMeasureRest(nm) && n)
-                              break;
+                  for (Measure* nm = m; n; nm = nm->nextMeasure()) {
                         lc.adjustMeasureNo(nm);
-                        ++n;
-                        len += nm->len();
-                        lm = nm;
-                        if (!(mb && mb->isMeasure()))
+                        if (nm == lm)
                               break;
-                        nm = toMeasure(mb);
                         }
                   if (n >= styleI(StyleIdx::minEmptyMeasures)) {
                         createMMRest(m, lm, len);
@@ -2488,7 +2585,7 @@ void Score::getNextMeasure(LayoutContext& lc)
 
       createBeams(measure);
 
-      for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
+      forEachStaff(nstaves(), [this, measure](int staffIdx) {
             for (Segment& segment : measure->segments()) {
                   if (segment.isChordRestType()) {
                         layoutChords1(&segment, staffIdx);
@@ -2499,7 +2596,7 @@ void Score::getNextMeasure(LayoutContext& lc)
                               }
                         }
                   }
-            }
+            });
 
       for (Segment& segment : measure->segments()) {
             if (segment.isBreathType()) {
@@ -2601,11 +2698,16 @@ void Score::getNextMeasure(LayoutContext& lc)
                               }
                         }
                   }
-            else if (s.isEndBarLineType())
-                  continue;
-            s.createShapes();
             }
 
+      // a segment shape only depends on the elements of the segment
+      forEachStaff(nstaves(), [measure](int staffIdx) {
+            for (Segment& s : measure->segments()) {
+                  if (!s.isEndBarLineType())
+                        s.createShape(staffIdx);
+                  }
+            });
+
       lc.tick += measure->ticks();
       }
 
@@ -2823,6 +2925,7 @@ System* Score::collectSystem(LayoutContext& lc)
             return 0;
             }
       System* system = getNextSystem(lc);
+      ++_layoutStats.systems;
       system->setInstrumentNames(lc.startWithLongNames);
 
       qreal minWidth    = 0;
@@ -2953,7 +3056,7 @@ System* Score::collectSystem(LayoutContext& lc)
             minWidth += ww;
             if (lc.rangeLayout && lc.endTick < lc.prevMeasure->tick()) {
                   // TODO: we may check if another measure fits in this system
-                  if (lc.prevMeasure == lc.systemOldMeasure) {
+                  if (lc.prevMeasure == lc.systemOldMeasure && system->width() == lc.systemOldWidth) {
                         lc.rangeDone = true;
                         if (lc.curMeasure && lc.curMeasure->isMeasure())
                               restoreBeams(toMeasure(lc.curMeasure));
@@ -3417,6 +3520,7 @@ bool Score::collectPage(LayoutContext& lc)
 void Score::doLayout()
       {
 //      qDebug("==========================");
+      ++_layoutStats.layouts;
 
       if (_staves.empty() || first() == 0) {
             // score is empty
@@ -3454,15 +3558,18 @@ void Score::doLayout()
             }
 
       // remove not needed systems
-      // TODO: make undoable
       for (System* system : lc.systemList) {
-            qDebug("delete system");
+            qDebug("free system");
             for (SpannerSegment* ss : system->spannerSegments()) {
                   qDebug("   delete spanner segment\n");
                   Spanner* spanner = ss->spanner();
                   spanner->spannerSegments().removeOne(ss);
                   }
+            system->clear();
             }
+      // undo commands may still refer to the dividers, brackets and
+      // instrument names of the systems, keep them for reuse
+      _freeSystems.append(lc.systemList);
       // remove not needed pages
       // TODO: make undoable
       while (_pages.size() > lc.curPage)
@@ -3486,6 +3593,85 @@ void Score::doLayout()
 #endif
       }
 
+//---------------------------------------------------------
+//   layoutChangesScore
+//    return true if the layout of s may create undo
+//    commands other than for multi measure rests, which
+//    are created before by createMMRests(): removal of a
+//    system divider or of a start repeat barline. All
+//    scores share the undo stack and the link ids of the
+//    master score, so such a layout must not run
+//    concurrently.
+//---------------------------------------------------------
+
+static bool layoutChangesScore(Score* s)
+      {
+      bool dividerLeft  = s->styleB(StyleIdx::dividerLeft);
+      bool dividerRight = s->styleB(StyleIdx::dividerRight);
+      for (System* system : s->systems()) {
+            SystemDivider* dl = system->systemDividerLeft();
+            SystemDivider* dr = system->systemDividerRight();
+            if ((!dividerLeft && dl && !dl->generated()) || (!dividerRight && dr && !dr->generated()))
+                  return true;
+            }
+      for (Measure* m = s->firstMeasure(); m; m = m->nextMeasure()) {
+            if (!m->repeatStart() && m->findSegmentR(Segment::Type::StartRepeatBarLine, 0))
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   layoutScores
+//    lay out a list of scores, typically a master score
+//    and its parts.
+//    In parallel layout mode the master scores are laid
+//    out first. Then the multi measure rests of the part
+//    scores are created one by one, as this goes through
+//    the undo stack. Then the part scores whose layout does
+//    not create other undo commands are laid out
+//    concurrently on the global thread pool, and the
+//    remaining parts one by one. A concurrent part layout
+//    only reads the tempo and time signature maps of its
+//    master score, which the master layout has rebuilt
+//    before.
+//---------------------------------------------------------
+
+void Score::layoutScores(const QList<Score*>& scores)
+      {
+      QList<Score*> parts;
+      QList<Score*> serialParts;
+      for (Score* s : scores) {
+            if (s->isMaster() || !MScore::parallelLayout)
+                  s->doLayout();
+            else if (layoutChangesScore(s))
+                  serialParts.append(s);
+            else
+                  parts.append(s);
+            }
+      for (Score* s : parts)
+            s->createMMRests();
+      if (parts.size() < 2 || QThreadPool::globalInstance()->maxThreadCount() < 2) {
+            for (Score* s : parts + serialParts)
+                  s->doLayout();
+            return;
+            }
+      // score fonts are loaded on first use, do it here and not
+      // in the worker threads
+      ScoreFont::fallbackFont();
+      for (Score* s : parts)
+            ScoreFont::fontFactory(s->styleSt(StyleIdx::MusicalSymbolFont));
+      // text layout depends on the render context of the caller
+      const RenderContext& ctx = MScore::renderContext();
+      QtConcurrent::blockingMap(parts, [&ctx](Score* s) {
+            RenderScope scope(ctx);
+            s->doLayout();
+            ++s->_layoutStats.concurrent;
+            });
+      for (Score* s : serialParts)
+            s->doLayout();
+      }
+
 //---------------------------------------------------------
 //   doLayoutRange
 //---------------------------------------------------------
@@ -3499,6 +3685,7 @@ void Score::doLayoutRange(int stick, int etick)
             }
       if (stick < 0)
             stick = 0;
+      ++_layoutStats.layouts;
       LayoutContext lc;
       lc.rangeLayout = true;
       lc.rangeDone   = false;
@@ -3551,16 +3738,21 @@ void Score::doLayoutRange(int stick, int etick)
       //---------------------------------------------------
 
       while (collectPage(lc)) {
-            Page* page     = _pages[lc.curPage-1];
-            System* s      = page->system(0);
-            MeasureBase* m = s->measures().back();
-            if (lc.rangeDone && m->tick() > etick) {
+            // once the systems are reused unchanged, the remaining
+            // pages are unchanged too if this page ends with the
+            // same system as before
+            Page* page = _pages[lc.curPage-1];
+            if (lc.rangeDone && page->systems().back() == lc.pageOldSystem)
                   break;
-                  }
             }
       if (!lc.curSystem) {
             while (_pages.size() > lc.curPage)        // Remove not needed pages. TODO: make undoable:
                   _pages.takeLast();
+            // all measures are collected, remaining old systems are obsolete
+            for (System* s : lc.systemList)
+                  s->clear();
+            _freeSystems.append(lc.systemList);
+            lc.systemList.clear();
             }
 
       _systems.append(lc.systemList);
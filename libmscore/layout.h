@@ -32,6 +32,7 @@ struct LayoutContext {
       QList<System*> systemList;          // reusable systems
       System* curSystem        { 0 };
       MeasureBase* systemOldMeasure;
+      qreal systemOldWidth     { 0.0 };
       bool rangeDone           { false };
       System* pageOldSystem    { 0 };
       bool systemChanged       { false };
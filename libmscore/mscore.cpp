@@ -71,10 +71,13 @@ bool MScore::noVerticalStretch   = false;
 bool MScore::showBoundingRect    = false;
 bool MScore::showCorruptedMeasures = true;
 bool MScore::useFallbackFont       = true;
+bool MScore::checkRenderMidi       = false;
 // #endif
 
 bool  MScore::saveTemplateMode = false;
 bool  MScore::noGui = false;
+bool  MScore::parallelLayout = false;
+int   MScore::undoMemoryLimit = 256;
 
 MStyle* MScore::_defaultStyle;
 MStyle* MScore::_defaultStyleForParts;
@@ -109,8 +112,9 @@ int     MScore::mtcType;
 
 bool    MScore::noExcerpts = false;
 bool    MScore::noImages = false;
-bool    MScore::pdfPrinting = false;
-double  MScore::pixelRatio  = 0.8;        // DPI / logicalDPI
+RenderContext MScore::_defaultRenderContext;
+
+static thread_local const RenderContext* currentRenderContext = 0;
 
 MPaintDevice* MScore::_paintDevice;
 
@@ -444,6 +448,31 @@ QQmlEngine* MScore::qml()
       return _qml;
       }
 
+//---------------------------------------------------------
+//   renderContext
+//    paint state of the calling thread
+//---------------------------------------------------------
+
+const RenderContext& MScore::renderContext()
+      {
+      return currentRenderContext ? *currentRenderContext : _defaultRenderContext;
+      }
+
+//---------------------------------------------------------
+//   RenderScope
+//---------------------------------------------------------
+
+RenderScope::RenderScope(const RenderContext& ctx)
+   : _saved(currentRenderContext)
+      {
+      currentRenderContext = &ctx;
+      }
+
+RenderScope::~RenderScope()
+      {
+      currentRenderContext = _saved;
+      }
+
 //---------------------------------------------------------
 //   paintDevice
 //---------------------------------------------------------
@@ -402,6 +402,35 @@ class MPaintDevice : public QPaintDevice {
       virtual ~MPaintDevice() {}
       };
 
+//---------------------------------------------------------
+//   RenderContext
+//    paint state which is not part of the score: device
+//    resolution and output mode. It is current per thread
+//    (see RenderScope), so that several threads can paint
+//    pages at the same time.
+//---------------------------------------------------------
+
+struct RenderContext {
+      qreal pixelRatio { 0.8 };     // DPI / logical DPI of the paint device, scales fonts
+      qreal dpi        { DPI };     // resolution of the paint device
+      bool printing    { false };   // do not draw unprintable elements (breaks, selection, ...)
+      bool pdf         { false };   // draw symbols as text for vector output
+      };
+
+//---------------------------------------------------------
+//   RenderScope
+//    makes a RenderContext current for the calling thread
+//    until the scope is left
+//---------------------------------------------------------
+
+class RenderScope {
+      const RenderContext* _saved;
+
+   public:
+      RenderScope(const RenderContext&);
+      ~RenderScope();
+      };
+
 //---------------------------------------------------------
 //   MScore
 //    MuseScore application object
@@ -417,6 +446,7 @@ class MScore : public QObject {
       static QString _globalShare;
       static int _hRaster, _vRaster;
       static bool _verticalOrientation;
+      static RenderContext _defaultRenderContext;
 
 #ifdef SCRIPT_INTERFACE
       static QQmlEngine* _qml;
@@ -474,6 +504,7 @@ class MScore : public QObject {
       static bool showBoundingRect;
       static bool showCorruptedMeasures;
       static bool useFallbackFont;
+      static bool checkRenderMidi;          // verify incremental Score::updateMidi() against renderMidi()
 // #endif
       static bool debugMode;
       static bool testMode;
@@ -485,12 +516,16 @@ class MScore : public QObject {
 
       static bool saveTemplateMode;
       static bool noGui;
+      static bool parallelLayout;         // distribute per staff layout work over the thread pool
+      static int undoMemoryLimit;         // undo history budget in MiB, 0: unlimited
 
       static bool noExcerpts;
       static bool noImages;
 
-      static bool pdfPrinting;
-      static double pixelRatio;
+      static const RenderContext& renderContext();
+      static void setDefaultPixelRatio(qreal val) { _defaultRenderContext.pixelRatio = val; }
+      static qreal pixelRatio()                   { return renderContext().pixelRatio; }
+      static bool pdfPrinting()                   { return renderContext().pdf; }
 
       static qreal verticalPageGap;
       static qreal horizontalPageGapEven;
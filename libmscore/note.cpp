@@ -769,7 +769,7 @@ void Note::draw(QPainter* painter) const
 //            qreal imag = 1.0 / mag;
 //            painter->scale(mag, mag);
             QFont f(tab->fretFont());
-            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
             painter->setFont(f);
             painter->setPen(c);
             painter->drawText(QPointF(bbox().x(), tab->fretFontYOffset()), s);
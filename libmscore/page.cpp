@@ -162,6 +162,18 @@ QList<Element*> Page::items(const QPointF& p)
 #endif
       }
 
+void Page::items(const QRectF& r, std::vector<Element*>* el)
+      {
+#ifdef USE_BSP
+      if (!bspTreeValid)
+            doRebuildBspTree();
+      bspTree.items(r, el);
+#else
+      Q_UNUSED(r)
+      Q_UNUSED(el)
+#endif
+      }
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -439,17 +451,21 @@ void PageFormat::write(Xml& xml) const
 
 #ifdef USE_BSP
 //---------------------------------------------------------
-//   bspInsert
+//   bspCollect
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, Element* e)
+static void bspCollect(void* data, Element* e)
       {
-      ((BspTree*) bspTree)->insert(e);
+      static_cast<std::vector<Element*>*>(data)->push_back(e);
       }
 
-static void countElements(void* data, Element* /*e*/)
+//---------------------------------------------------------
+//   bspUpdate
+//---------------------------------------------------------
+
+static void bspUpdate(void* bspTree, Element* e)
       {
-      ++(*(int*)data);
+      static_cast<RTree*>(bspTree)->update(e);
       }
 
 //---------------------------------------------------------
@@ -458,30 +474,56 @@ static void countElements(void* data, Element* /*e*/)
 
 void Page::doRebuildBspTree()
       {
-      int n = 0;
-      scanElements(&n, countElements, false);
-
-      QRectF r;
-      if (score()->layoutMode() == LayoutMode::LINE) {
-            qreal w = 0.0;
-            qreal h = 0.0;
-            if (!_systems.empty()) {
-                  h = _systems.front()->height();
-                  if (!_systems.front()->measures().empty()) {
-                        MeasureBase* mb = _systems.front()->measures().back();
-                        w = mb->x() + mb->width();
-                        }
+      std::vector<Element*> el;
+      scanElements(&el, bspCollect, false);
+      bspTree.build(el);
+      bspTreeValid = true;
+      }
+#endif
+
+//---------------------------------------------------------
+//   displayList
+//    all elements of the page in paint order, with their
+//    page positions resolved; rebuilt lazily after layout
+//    or edits touching the page
+//---------------------------------------------------------
+
+const std::vector<DisplayItem>& Page::displayList()
+      {
+      if (!_displayListValid) {
+            QList<Element*> el = elements();
+            qStableSort(el.begin(), el.end(), elementLessThan);
+            _displayList.clear();
+            _displayList.reserve(el.size());
+            for (Element* e : el) {
+                  QPointF pos(e->pagePos());
+                  _displayList.push_back({ e, pos, e->bbox().translated(pos) });
                   }
-            r = QRectF(0.0, 0.0, w, h);
+            _displayListValid = true;
             }
-      else
-            r = abbox();
-
-      bspTree.initialize(r, n);
-      scanElements(&bspTree, &bspInsert, false);
-      bspTreeValid = true;
+      return _displayList;
       }
+
+//---------------------------------------------------------
+//   updateBspTree
+//    update the index in place for an element (and its
+//    children) which moved without changing the structure
+//    of the page
+//---------------------------------------------------------
+
+void Page::updateBspTree(Element* e)
+      {
+      _displayListValid = false;
+#ifdef USE_BSP
+      if (!bspTreeValid)
+            return;
+      e->scanElements(&bspTree, bspUpdate, false);
+      if (bspTree.needsRebuild())
+            bspTreeValid = false;
+#else
+      Q_UNUSED(e)
 #endif
+      }
 
 //---------------------------------------------------------
 //   replaceTextMacros
@@ -15,7 +15,7 @@
 
 #include "config.h"
 #include "element.h"
-#include "bsp.h"
+#include "rtree.h"
 
 namespace Ms {
 
@@ -39,6 +39,18 @@ struct PaperSize {
 
 extern const PaperSize* getPaperSize(const qreal wi, const qreal hi);
 
+//---------------------------------------------------------
+//   DisplayItem
+//    element of a page display list with its position
+//    and bounding box in page coordinates
+//---------------------------------------------------------
+
+struct DisplayItem {
+      Element* element;
+      QPointF pos;
+      QRectF box;
+      };
+
 //---------------------------------------------------------
 //   @@ PageFormat
 //   @P evenBottomMargin  float
@@ -129,10 +141,12 @@ class Page : public Element {
       QList<System*> _systems;
       int _no;                      // page number
 #ifdef USE_BSP
-      BspTree bspTree;
+      RTree bspTree;
       void doRebuildBspTree();
 #endif
       bool bspTreeValid;
+      std::vector<DisplayItem> _displayList;      // page elements sorted by z
+      bool _displayListValid { false };
 
       QString replaceTextMacros(const QString&) const;
       void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -165,7 +179,11 @@ class Page : public Element {
 
       QList<Element*> items(const QRectF& r);
       QList<Element*> items(const QPointF& p);
-      void rebuildBspTree()   { bspTreeValid = false; }
+      void items(const QRectF& r, std::vector<Element*>* el);
+      void rebuildBspTree()   { bspTreeValid = false; _displayListValid = false; }
+      const std::vector<DisplayItem>& displayList();
+      void invalidateDisplayList() { _displayListValid = false; }
+      void updateBspTree(Element*);
       QPointF pagePos() const { return QPointF(); }     ///< position in page coordinates
       QList<System*> searchSystem(const QPointF& pos) const;
       Measure* searchMeasure(const QPointF& p) const;
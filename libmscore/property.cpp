@@ -31,6 +31,7 @@ struct PropertyData {
       bool link;              // link this property for linked elements
       const char* name;       // xml name of property
       P_TYPE type;
+      PropertyInvalidation invalidation;  // default LAYOUT
       };
 
 //
@@ -39,11 +40,11 @@ struct PropertyData {
 //
 static const PropertyData propertyList[] = {
       { P_ID::SUBTYPE,             false,  "subtype",      P_TYPE::INT    },
-      { P_ID::SELECTED,            false, "selected",      P_TYPE::BOOL   },
+      { P_ID::SELECTED,            false, "selected",      P_TYPE::BOOL, PropertyInvalidation::RENDER },
       { P_ID::GENERATED,           false,  "generated",    P_TYPE::BOOL   },
-      { P_ID::COLOR,               false, "color",         P_TYPE::COLOR  },
+      { P_ID::COLOR,               false, "color",         P_TYPE::COLOR, PropertyInvalidation::RENDER },
       { P_ID::VISIBLE,             false, "visible",       P_TYPE::BOOL   },
-      { P_ID::Z,                   false, "z",             P_TYPE::INT   },
+      { P_ID::Z,                   false, "z",             P_TYPE::INT, PropertyInvalidation::RENDER },
       { P_ID::SMALL,               false, "small",         P_TYPE::BOOL   },
       { P_ID::SHOW_COURTESY,       false, "showCourtesy",  P_TYPE::INT    },
       { P_ID::LINE_TYPE,           false, "lineType",      P_TYPE::INT    },
@@ -56,8 +57,8 @@ static const PropertyData propertyList[] = {
       { P_ID::FIXED_LINE,          false, "fixedLine",     P_TYPE::INT    },
       { P_ID::HEAD_TYPE,           false, "headType",      P_TYPE::HEAD_TYPE   },
       { P_ID::HEAD_GROUP,          false, "head",          P_TYPE::HEAD_GROUP  },
-      { P_ID::VELO_TYPE,           false, "veloType",      P_TYPE::VALUE_TYPE  },
-      { P_ID::VELO_OFFSET,         false, "velocity",      P_TYPE::INT  },
+      { P_ID::VELO_TYPE,           false, "veloType",      P_TYPE::VALUE_TYPE, PropertyInvalidation::PLAYBACK },
+      { P_ID::VELO_OFFSET,         false, "velocity",      P_TYPE::INT, PropertyInvalidation::PLAYBACK },
       { P_ID::ARTICULATION_ANCHOR, false, "anchor",        P_TYPE::INT  },
       { P_ID::DIRECTION,           false, "direction",     P_TYPE::DIRECTION  },
       { P_ID::STEM_DIRECTION,      true,  "StemDirection", P_TYPE::DIRECTION  },
@@ -68,7 +69,7 @@ static const PropertyData propertyList[] = {
       { P_ID::DISTRIBUTE,          false, "distribute",    P_TYPE::BOOL  },
       { P_ID::MIRROR_HEAD,         false, "mirror",        P_TYPE::DIRECTION_H  },
       { P_ID::DOT_POSITION,        false, "dotPosition",   P_TYPE::DIRECTION  },
-      { P_ID::TUNING,              false, "tuning",        P_TYPE::REAL   },
+      { P_ID::TUNING,              false, "tuning",        P_TYPE::REAL, PropertyInvalidation::PLAYBACK },
       { P_ID::PAUSE,               false, "pause",         P_TYPE::REAL   },
 
       { P_ID::BARLINE_TYPE,        false, 0,               P_TYPE::BARLINE_TYPE  },
@@ -80,7 +81,7 @@ static const PropertyData propertyList[] = {
       { P_ID::FRET,                true,  "fret",          P_TYPE::INT },
       { P_ID::STRING,              true,  "string",        P_TYPE::INT },
       { P_ID::GHOST,               true,  "ghost",         P_TYPE::BOOL },
-      { P_ID::PLAY,                false, "play",          P_TYPE::BOOL },
+      { P_ID::PLAY,                false, "play",          P_TYPE::BOOL, PropertyInvalidation::PLAYBACK },
       { P_ID::TIMESIG_NOMINAL,     false, 0,               P_TYPE::FRACTION  },
       { P_ID::TIMESIG_ACTUAL,      true,  0,               P_TYPE::FRACTION  },
       { P_ID::NUMBER_TYPE,         false, "numberType",    P_TYPE::INT },
@@ -143,10 +144,10 @@ static const PropertyData propertyList[] = {
       { P_ID::HAIRPIN_TYPE,        true,  "",                  P_TYPE::INT      },
       { P_ID::HAIRPIN_HEIGHT,      false, "hairpinHeight",     P_TYPE::SPATIUM  },
       { P_ID::HAIRPIN_CONT_HEIGHT, false, "hairpinContHeight", P_TYPE::SPATIUM  },
-      { P_ID::VELO_CHANGE,         true,  "veloChange",        P_TYPE::INT     },
-      { P_ID::DYNAMIC_RANGE,       true,  "dynType",       P_TYPE::INT     },
+      { P_ID::VELO_CHANGE,         true,  "veloChange",        P_TYPE::INT, PropertyInvalidation::PLAYBACK },
+      { P_ID::DYNAMIC_RANGE,       true,  "dynType",       P_TYPE::INT, PropertyInvalidation::PLAYBACK },
       { P_ID::PLACEMENT,           false, "placement",     P_TYPE::PLACEMENT     },
-      { P_ID::VELOCITY,            false, "velocity",      P_TYPE::INT     },
+      { P_ID::VELOCITY,            false, "velocity",      P_TYPE::INT, PropertyInvalidation::PLAYBACK },
       { P_ID::JUMP_TO,             false, "jumpTo",        P_TYPE::STRING  },
       { P_ID::PLAY_UNTIL,          false, "playUntil",     P_TYPE::STRING  },
 
@@ -168,7 +169,7 @@ static const PropertyData propertyList[] = {
       { P_ID::DIAGONAL,            false, 0,                       P_TYPE::BOOL      },
       { P_ID::GROUPS,              false, 0,                       P_TYPE::GROUPS    },
       { P_ID::LINE_STYLE,          false, "lineStyle",             P_TYPE::INT       },
-      { P_ID::LINE_COLOR,          false, 0,                       P_TYPE::COLOR     },
+      { P_ID::LINE_COLOR,          false, 0,                       P_TYPE::COLOR, PropertyInvalidation::RENDER },
       { P_ID::LINE_WIDTH,          false, "lineWidth",             P_TYPE::SPATIUM   },
       { P_ID::LASSO_POS,           false, 0,                       P_TYPE::POINT_MM  },
       { P_ID::LASSO_SIZE,          false, 0,                       P_TYPE::SIZE_MM   },
@@ -265,6 +266,16 @@ P_TYPE propertyType(P_ID id)
       return propertyList[int(id)].type;
       }
 
+//---------------------------------------------------------
+//   propertyInvalidation
+//---------------------------------------------------------
+
+PropertyInvalidation propertyInvalidation(P_ID id)
+      {
+      Q_ASSERT( propertyList[int(id)].id == id);
+      return propertyList[int(id)].invalidation;
+      }
+
 //---------------------------------------------------------
 //   propertyLink
 //---------------------------------------------------------
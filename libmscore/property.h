@@ -26,6 +26,17 @@ enum class PropertyStyle : char {
       NOSTYLE, UNSTYLED, STYLED
       };
 
+//---------------------------------------------------------
+//   PropertyInvalidation
+//    what has to be done after a property changed
+//---------------------------------------------------------
+
+enum class PropertyInvalidation : char {
+      LAYOUT,           // layout the affected range, implies PLAYBACK and RENDER
+      PLAYBACK,         // only the play events of the element change
+      RENDER            // repaint the element, geometry is unchanged
+      };
+
 //------------------------------------------------------------------------
 //   Element Properties
 //------------------------------------------------------------------------
@@ -286,6 +297,7 @@ extern QVariant getProperty(P_ID type, XmlReader& e);
 extern P_TYPE propertyType(P_ID);
 extern const char* propertyName(P_ID);
 extern bool propertyLink(P_ID id);
+extern PropertyInvalidation propertyInvalidation(P_ID);
 
 }     // namespace Ms
 #endif
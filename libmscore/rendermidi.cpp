@@ -178,7 +178,7 @@ void MasterScore::updateChannel()
 //---------------------------------------------------------
 
 static void playNote(EventMap* events, const Note* note, int channel, int pitch,
-   int velo, int onTime, int offTime)
+   int velo, int onTime, int offTime, int origin)
       {
       if (!note->play())
             return;
@@ -186,6 +186,7 @@ static void playNote(EventMap* events, const Note* note, int channel, int pitch,
       NPlayEvent ev(ME_NOTEON, channel, pitch, velo);
       ev.setTuning(note->tuning());
       ev.setNote(note);
+      ev.setOrigin(origin);
       events->insert(std::pair<int, NPlayEvent>(onTime, ev));
       ev.setVelo(0);
       events->insert(std::pair<int, NPlayEvent>(offTime, ev));
@@ -193,9 +194,11 @@ static void playNote(EventMap* events, const Note* note, int channel, int pitch,
 
 //---------------------------------------------------------
 //   collectNote
+//    origin is the utick of the measure being rendered,
+//    all generated events are tagged with it
 //---------------------------------------------------------
 
-static void collectNote(EventMap* events, int channel, const Note* note, int velo, int tickOffset)
+static void collectNote(EventMap* events, int channel, const Note* note, int velo, int tickOffset, int origin)
       {
       if (!note->play() || note->hidden())      // do not play overlapping notes
             return;
@@ -228,7 +231,7 @@ static void collectNote(EventMap* events, int channel, const Note* note, int vel
                               }
                         else {
                               // recurse
-                              collectNote(events, channel, n, velo, tickOffset);
+                              collectNote(events, channel, n, velo, tickOffset, origin);
                               break;
                               }
                         if (n->tieFor() && n != n->tieFor()->endNote())
@@ -263,7 +266,7 @@ static void collectNote(EventMap* events, int channel, const Note* note, int vel
             int off = on + (ticks * e.len())/1000 - 1;
             if (tieFor && i == nels - 1)
                   off += tieLen;
-            playNote(events, note, channel, p, velo, on, off);
+            playNote(events, note, channel, p, velo, on, off, origin);
             }
 
       // Bends
@@ -289,6 +292,7 @@ static void collectNote(EventMap* events, int channel, const Note* note, int vel
                         int msb = midiPitch / 128;
                         int lsb = midiPitch % 128;
                         NPlayEvent ev(ME_PITCHBEND, channel, lsb, msb);
+                        ev.setOrigin(origin);
                         events->insert(std::pair<int, NPlayEvent>(lastPointTick, ev));
                         lastPointTick = nextPointTick;
                         continue;
@@ -316,11 +320,13 @@ static void collectNote(EventMap* events, int channel, const Note* note, int vel
                         int msb = midiPitch / 128;
                         int lsb = midiPitch % 128;
                         NPlayEvent ev(ME_PITCHBEND, channel, lsb, msb);
+                        ev.setOrigin(origin);
                         events->insert(std::pair<int, NPlayEvent>(i, ev));
                         }
                   lastPointTick = nextPointTick;
                   }
             NPlayEvent ev(ME_PITCHBEND, channel, 0, 64); // 0:64 is 8192 - no pitch bend
+            ev.setOrigin(origin);
             events->insert(std::pair<int, NPlayEvent>(tick1+noteLen, ev));
             }
       }
@@ -329,9 +335,10 @@ static void collectNote(EventMap* events, int channel, const Note* note, int vel
 //   aeolusSetStop
 //---------------------------------------------------------
 
-static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMap* events)
+static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMap* events, int origin)
       {
       NPlayEvent event;
+      event.setOrigin(origin);
       event.setType(ME_CONTROLLER);
       event.setController(98);
       if (val)
@@ -354,6 +361,7 @@ static void aeolusSetStop(int tick, int channel, int i, int k, bool val, EventMa
 
 static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int tickOffset)
       {
+      int origin        = m->tick() + tickOffset;
       int firstStaffIdx = staff->idx();
       int nextStaffIdx  = firstStaffIdx + 1;
 
@@ -376,7 +384,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   Chord* chord = static_cast<Chord*>(cr);
                   Staff* staff = chord->staff();
                   int velocity = staff->velocities().velo(seg->tick());
-                  Instrument* instr = chord->part()->instrument(tick);
+                  const Instrument* instr = chord->part()->instrument(tick);
                   int channel = instr->channel(chord->upNote()->subchannel())->channel;
 
                   for (Articulation* a : chord->articulations())
@@ -385,15 +393,15 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   if ( !graceNotesMerged(chord))
                       for (Chord* c : chord->graceNotesBefore())
                           for (const Note* note : c->notes())
-                              collectNote(events, channel, note, velocity, tickOffset);
+                              collectNote(events, channel, note, velocity, tickOffset, origin);
 
                   for (const Note* note : chord->notes())
-                        collectNote(events, channel, note, velocity, tickOffset);
+                        collectNote(events, channel, note, velocity, tickOffset, origin);
 
                   if ( !graceNotesMerged(chord))
                       for (Chord* c : chord->graceNotesAfter())
                           for (const Note* note : c->notes())
-                              collectNote(events, channel, note, velocity, tickOffset);
+                              collectNote(events, channel, note, velocity, tickOffset, origin);
                  }
             }
 
@@ -410,7 +418,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                   const StaffText* st = static_cast<const StaffText*>(e);
                   int tick = s->tick() + tickOffset;
 
-                  Instrument* instr = e->part()->instrument(tick);
+                  const Instrument* instr = e->part()->instrument(tick);
                   for (const ChannelActions& ca : *st->channelActions()) {
                         int channel = instr->channel().at(ca.channel)->channel;
                         for (const QString& ma : ca.midiActionNames) {
@@ -420,6 +428,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                               for (MidiCoreEvent event : nel->events) {
                                     event.setChannel(channel);
                                     NPlayEvent e(event);
+                                    e.setOrigin(origin);
                                     if (e.dataA() == CTRL_PROGRAM)
                                           events->insert(std::pair<int, NPlayEvent>(tick-1, e));
                                     else
@@ -435,7 +444,7 @@ static void collectMeasureEvents(EventMap* events, Measure* m, Staff* staff, int
                         for (int i = 0; i < 4; ++i) {
                               static int num[4] = { 12, 13, 16, 16 };
                               for (int k = 0; k < num[i]; ++k)
-                                    aeolusSetStop(tick, channel, i, k, st->getAeolusStop(i, k), events);
+                                    aeolusSetStop(tick, channel, i, k, st->getAeolusStop(i, k), events, origin);
                               }
                         }
                   }
@@ -624,9 +633,11 @@ void Score::updateVelo()
 
 //---------------------------------------------------------
 //   renderStaff
+//    render only measures starting in tick1 - tick2,
+//    tick2 == -1 means up to the end of the score
 //---------------------------------------------------------
 
-void Score::renderStaff(EventMap* events, Staff* staff)
+void Score::renderStaff(EventMap* events, Staff* staff, int tick1, int tick2)
       {
       Measure* lastMeasure = 0;
       for (const RepeatSegment* rs : *repeatList()) {
@@ -634,13 +645,16 @@ void Score::renderStaff(EventMap* events, Staff* staff)
             int endTick    = startTick + rs->len;
             int tickOffset = rs->utick - rs->tick;
             for (Measure* m = tick2measure(startTick); m; m = m->nextMeasure()) {
+                  bool render = m->tick() >= tick1 && (tick2 == -1 || m->tick() < tick2);
                   if (lastMeasure && m->isRepeatMeasure(staff)) {
                         int offset = m->tick() - lastMeasure->tick();
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset + offset);
+                        if (render)
+                              collectMeasureEvents(events, lastMeasure, staff, tickOffset + offset);
                         }
                   else {
                         lastMeasure = m;
-                        collectMeasureEvents(events, lastMeasure, staff, tickOffset);
+                        if (render)
+                              collectMeasureEvents(events, lastMeasure, staff, tickOffset);
                         }
                   if (m->tick() + m->ticks() >= endTick)
                         break;
@@ -1646,10 +1660,21 @@ void Score::createPlayEvents(Chord* chord)
       }
 
 void Score::createPlayEvents()
+      {
+      createPlayEvents(firstMeasure(), 0);
+      }
+
+//---------------------------------------------------------
+//   createPlayEvents
+//    create play events for all chords in measures
+//    start - end; end == 0 means up to the end of the score
+//---------------------------------------------------------
+
+void Score::createPlayEvents(Measure* start, Measure* end)
       {
       int etrack = nstaves() * VOICES;
       for (int track = 0; track < etrack; ++track) {
-            for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
+            for (Measure* m = start; m; m = m->nextMeasure()) {
                   // skip linked staves, except primary
                   if (!m->score()->staff(track / VOICES)->primaryStaff())
                         continue;
@@ -1660,6 +1685,8 @@ void Score::createPlayEvents()
                               continue;
                         createPlayEvents(chord);
                         }
+                  if (m == end)
+                        break;
                   }
             }
       }
@@ -1692,6 +1719,80 @@ void Score::renderMetronome(EventMap* events, Measure* m, int tickOffset)
             events->insert(std::pair<int,NPlayEvent>(tick + tickOffset, NPlayEvent(timeSig.rtick2beatType(rtick))));
       }
 
+//---------------------------------------------------------
+//   renderMetronome
+//    add metronome ticks for the whole score
+//---------------------------------------------------------
+
+void Score::renderMetronome(EventMap* events)
+      {
+      for (const RepeatSegment* rs : *repeatList()) {
+            int startTick  = rs->tick;
+            int endTick    = startTick + rs->len;
+            int tickOffset = rs->utick - rs->tick;
+
+            for (Measure* m = tick2measure(startTick); m; m = m->nextMeasure()) {
+                  renderMetronome(events, m, tickOffset);
+                  if (m->tick() + m->ticks() >= endTick)
+                        break;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   StaffEvents
+//    per staff event buffer for parallel rendering
+//---------------------------------------------------------
+
+struct StaffEvents {
+      Score* score;
+      Staff* staff;
+      EventMap events;
+      };
+
+static void renderStaffEvents(StaffEvents& se)
+      {
+      se.score->renderStaff(&se.events, se.staff);
+      }
+
+//---------------------------------------------------------
+//   renderStaves
+//    create note & other events of all staves
+//
+//    Staves only read the score, the repeat list and the
+//    velocity lists, so they are rendered concurrently into
+//    separate buffers. The buffers are merged in tick order;
+//    events at the same tick keep staff order, which gives
+//    the same map as rendering the staves one by one.
+//---------------------------------------------------------
+
+void Score::renderStaves(EventMap* events)
+      {
+      if (nstaves() < 2 || QThreadPool::globalInstance()->maxThreadCount() < 2) {
+            for (Staff* staff : _staves)
+                  renderStaff(events, staff);
+            return;
+            }
+      std::vector<StaffEvents> staves(nstaves());
+      for (int i = 0; i < nstaves(); ++i) {
+            staves[i].score = this;
+            staves[i].staff = staff(i);
+            }
+      QtConcurrent::blockingMap(staves, renderStaffEvents);
+
+      std::vector<std::pair<int, NPlayEvent>> merged;
+      size_t n = 0;
+      for (const StaffEvents& se : staves)
+            n += se.events.size();
+      merged.reserve(n);
+      for (const StaffEvents& se : staves)
+            merged.insert(merged.end(), se.events.cbegin(), se.events.cend());
+      std::stable_sort(merged.begin(), merged.end(),
+         [](const std::pair<int, NPlayEvent>& a, const std::pair<int, NPlayEvent>& b) { return a.first < b.first; });
+      for (const auto& e : merged)
+            events->insert(events->end(), e);
+      }
+
 //---------------------------------------------------------
 //   renderMidi
 //    export score to event list
@@ -1708,26 +1809,286 @@ void Score::renderMidi(EventMap* events)
       updateVelo();
 
       // create note & other events
-      for (Staff* part : _staves)
-            renderStaff(events, part);
+      renderStaves(events);
 
       // create sustain pedal events
       renderSpanners(events, -1);
 
       // add metronome ticks
-      for (const RepeatSegment* rs : *repeatList()) {
-            int startTick  = rs->tick;
-            int endTick    = startTick + rs->len;
-            int tickOffset = rs->utick - rs->tick;
+      renderMetronome(events);
+      }
 
-            //
-            //    add metronome tick events
-            //
-            for (Measure* m = tick2measure(startTick); m; m = m->nextMeasure()) {
-                  renderMetronome(events, m, tickOffset);
-                  if (m->tick() + m->ticks() >= endTick)
+//---------------------------------------------------------
+//   setPlayRangeDirty
+//    remember ticks changed by a command; the next
+//    updateMidi() renders the measures around them again
+//---------------------------------------------------------
+
+void Score::setPlayRangeDirty(int tick1, int tick2)
+      {
+      if (tick2 < tick1)
+            std::swap(tick1, tick2);
+      if (_playDirtyTick1 == -1 || tick1 < _playDirtyTick1)
+            _playDirtyTick1 = tick1;
+      if (_playDirtyTick2 == -1 || tick2 > _playDirtyTick2)
+            _playDirtyTick2 = tick2;
+      }
+
+//---------------------------------------------------------
+//   playSignature
+//    collect the state which affects the events of all
+//    measures: if it changes, everything has to be
+//    rendered again
+//---------------------------------------------------------
+
+static QVector<qintptr> playSignature(Score* score)
+      {
+      QVector<qintptr> sig;
+      sig << score->nmeasures();
+      if (score->lastMeasure())
+            sig << score->lastMeasure()->endTick();
+      for (const RepeatSegment* rs : *score->repeatList())
+            sig << rs->tick << rs->len << rs->utick;
+      sig << -1;
+      for (Staff* st : score->staves()) {
+            for (auto i = st->swingList()->cbegin(); i != st->swingList()->cend(); ++i)
+                  sig << i.key() << i.value().swingUnit << i.value().swingRatio;
+            sig << -1;
+            for (int voice = 0; voice < VOICES; ++voice) {
+                  for (auto i = st->channelList(voice)->cbegin(); i != st->channelList(voice)->cend(); ++i)
+                        sig << i.key() << i.value();
+                  sig << -1;
+                  }
+            }
+      for (Part* part : score->parts()) {
+            for (const auto& i : *part->instruments())
+                  sig << i.first << qintptr(i.second);
+            sig << -1;
+            }
+      return sig;
+      }
+
+//---------------------------------------------------------
+//   veloChangeRange
+//    extend tick1 - tick2 by the ticks where the velocity
+//    computed from velocity lists o and n differs
+//---------------------------------------------------------
+
+static void veloChangeRange(const VeloList& o, const VeloList& n, int* tick1, int* tick2)
+      {
+      if (o.size() == n.size()) {
+            bool same = true;
+            for (auto i = o.cbegin(), k = n.cbegin(); i != o.cend(); ++i, ++k) {
+                  if (i.key() != k.key() || i.value().type != k.value().type || i.value().val != k.value().val) {
+                        same = false;
                         break;
+                        }
+                  }
+            if (same)
+                  return;
+            }
+      std::vector<int> ticks;
+      for (auto i = o.cbegin(); i != o.cend(); ++i)
+            ticks.push_back(i.key());
+      for (auto i = n.cbegin(); i != n.cend(); ++i)
+            ticks.push_back(i.key());
+      std::sort(ticks.begin(), ticks.end());
+      ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+
+      int nticks = int(ticks.size());
+      for (int idx = 0; idx < nticks; ++idx) {
+            int tick = ticks[idx];
+            auto i   = o.find(tick);
+            auto k   = n.find(tick);
+            bool changed = (i == o.cend()) != (k == n.cend())
+               || (i != o.cend() && (i.value().type != k.value().type || i.value().val != k.value().val));
+            if (!changed)
+                  continue;
+            // a ramp interpolates towards the next event: the change
+            // is audible from the previous event up to the next one
+            int t1 = idx > 0 ? ticks[idx - 1] : 0;
+            int t2 = idx < nticks - 1 ? ticks[idx + 1] : -1;
+            if (*tick1 == -1 || t1 < *tick1)
+                  *tick1 = t1;
+            if (*tick2 != -1 && (t2 == -1 || t2 > *tick2))
+                  *tick2 = t2;
+            if (t2 == -1)
+                  break;
+            }
+      }
+
+//---------------------------------------------------------
+//   hasTies
+//    true if a note in measure m is tied to the previous
+//    (back) or next (!back) measure
+//---------------------------------------------------------
+
+static bool hasTies(Measure* m, bool back)
+      {
+      int ntracks = m->score()->ntracks();
+      for (Segment* s = m->first(Segment::Type::ChordRest); s; s = s->next(Segment::Type::ChordRest)) {
+            for (int track = 0; track < ntracks; ++track) {
+                  Element* e = s->element(track);
+                  if (!e || e->type() != Element::Type::CHORD)
+                        continue;
+                  for (const Note* note : static_cast<Chord*>(e)->notes()) {
+                        if (back ? (note->tieBack() != 0) : (note->tieFor() != 0))
+                              return true;
+                        }
                   }
             }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   isRepeatMeasure
+//    true if m repeats the previous measure on any staff
+//---------------------------------------------------------
+
+static bool isRepeatMeasure(Score* score, Measure* m)
+      {
+      for (Staff* staff : score->staves()) {
+            if (m->isRepeatMeasure(staff))
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   sameEvents
+//    compare two event maps, ignoring the order of
+//    events at the same tick
+//---------------------------------------------------------
+
+static bool sameEvents(const EventMap& a, const EventMap& b, int* tick)
+      {
+      typedef std::tuple<int, int, int, int, float, const Note*> EventKey;
+      auto ia = a.cbegin();
+      auto ib = b.cbegin();
+      while (ia != a.cend() || ib != b.cend()) {
+            if (ia == a.cend() || ib == b.cend() || ia->first != ib->first) {
+                  *tick = ia == a.cend() ? ib->first : ia->first;
+                  return false;
+                  }
+            int t = ia->first;
+            std::vector<EventKey> ea;
+            std::vector<EventKey> eb;
+            for (; ia != a.cend() && ia->first == t; ++ia) {
+                  const NPlayEvent& e = ia->second;
+                  ea.push_back(EventKey(e.type(), e.channel(), e.dataA(), e.dataB(), e.tuning(), e.note()));
+                  }
+            for (; ib != b.cend() && ib->first == t; ++ib) {
+                  const NPlayEvent& e = ib->second;
+                  eb.push_back(EventKey(e.type(), e.channel(), e.dataA(), e.dataB(), e.tuning(), e.note()));
+                  }
+            std::sort(ea.begin(), ea.end());
+            std::sort(eb.begin(), eb.end());
+            if (ea != eb) {
+                  *tick = t;
+                  return false;
+                  }
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   updateMidi
+//    bring an event list created by renderMidi() or
+//    updateMidi() up to date with the score. Only the
+//    measures changed since the last call (plus
+//    neighbours, tie chains and measure repeats) are
+//    rendered again; changes of the repeat list, swing,
+//    channel switches or instruments need a full render.
+//---------------------------------------------------------
+
+void Score::updateMidi(EventMap* events)
+      {
+      bool all = _playAllDirty || !firstMeasure() || _playVelocities.size() != nstaves();
+      if (!all && _playDirtyTick1 == -1)
+            return;                 // nothing changed since last update
+      int tick1 = _playDirtyTick1;
+      int tick2 = _playDirtyTick2;
+
+      if (!all) {
+            updateSwing();
+            updateRepeatList(MScore::playRepeats);
+            _foundPlayPosAfterRepeats = false;
+            masterScore()->updateChannel();
+            updateVelo();
+            all = playSignature(this) != _playSignature;
+            }
+      if (!all) {
+            for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx)
+                  veloChangeRange(_playVelocities[staffIdx], staff(staffIdx)->velocities(), &tick1, &tick2);
+
+            Measure* lm = lastMeasure();
+            Measure* m1 = tick2measure(qBound(0, tick1, lm->tick()));
+            Measure* m2 = (tick2 == -1) ? lm : tick2measure(qBound(0, tick2, lm->tick()));
+            if (!m1 || !m2 || m2->tick() < m1->tick())
+                  all = true;
+            else {
+                  // events of notes tied over barlines are generated by the first note
+                  // of the tie chain, repeat measures play the preceding measure
+                  if (m1->prevMeasure())
+                        m1 = m1->prevMeasure();
+                  while (m1->prevMeasure() && hasTies(m1, true))
+                        m1 = m1->prevMeasure();
+                  if (m2->nextMeasure())
+                        m2 = m2->nextMeasure();
+                  while (m2->nextMeasure() && (hasTies(m2, false) || isRepeatMeasure(this, m2->nextMeasure())))
+                        m2 = m2->nextMeasure();
+
+                  createPlayEvents(m1, m2);
+
+                  // remove the events of all rendered occurrences of m1 - m2
+                  // and the events not bound to a measure
+                  int rtick1 = m1->tick();
+                  int rtick2 = m2->endTick();
+                  std::set<int> origins;
+                  for (const RepeatSegment* rs : *repeatList()) {
+                        int tickOffset = rs->utick - rs->tick;
+                        int endTick    = rs->tick + rs->len;
+                        for (Measure* m = m1; m && m->tick() < endTick; m = m->nextMeasure()) {
+                              if (m->tick() >= rs->tick)
+                                    origins.insert(m->tick() + tickOffset);
+                              if (m == m2)
+                                    break;
+                              }
+                        }
+                  for (auto i = events->begin(); i != events->end();) {
+                        int origin = i->second.origin();
+                        if (origin == -1 || origins.count(origin))
+                              i = events->erase(i);
+                        else
+                              ++i;
+                        }
+
+                  for (Staff* st : _staves)
+                        renderStaff(events, st, rtick1, rtick2);
+                  renderSpanners(events, -1);
+                  renderMetronome(events);
+                  }
+            }
+      if (all) {
+            events->clear();
+            renderMidi(events);
+            }
+      else if (MScore::checkRenderMidi) {
+            EventMap full;
+            renderMidi(&full);
+            int tick;
+            if (!sameEvents(*events, full, &tick)) {
+                  qDebug("Score::updateMidi: incremental events differ from renderMidi() at tick %d", tick);
+                  *events = full;
+                  }
+            }
+
+      _playSignature = playSignature(this);
+      _playVelocities.clear();
+      for (Staff* st : _staves)
+            _playVelocities.append(st->velocities());
+      _playAllDirty   = false;
+      _playDirtyTick1 = -1;
+      _playDirtyTick2 = -1;
       }
 }
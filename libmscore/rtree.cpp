@@ -0,0 +1,302 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "rtree.h"
+#include "element.h"
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   unite
+//    unlike QRectF::united() empty rectangles
+//    (lines, points) still extend the result
+//---------------------------------------------------------
+
+static inline QRectF unite(const QRectF& a, const QRectF& b)
+      {
+      return QRectF(QPointF(qMin(a.left(), b.left()), qMin(a.top(), b.top())),
+         QPointF(qMax(a.right(), b.right()), qMax(a.bottom(), b.bottom())));
+      }
+
+//---------------------------------------------------------
+//   overlaps
+//    inclusive test, used for pruning only
+//---------------------------------------------------------
+
+static inline bool overlaps(const QRectF& a, const QRectF& b)
+      {
+      return a.left() <= b.right() && b.left() <= a.right()
+         && a.top() <= b.bottom() && b.top() <= a.bottom();
+      }
+
+static inline bool covers(const QRectF& a, const QPointF& p)
+      {
+      return a.left() <= p.x() && p.x() <= a.right() && a.top() <= p.y() && p.y() <= a.bottom();
+      }
+
+//---------------------------------------------------------
+//   strOrder
+//    sort-tile-recursive order: sort by x center, cut into
+//    sqrt(n / NODE_SIZE) vertical slices and sort every
+//    slice by y center. Consecutive runs of NODE_SIZE
+//    items then form the nodes of the next level.
+//---------------------------------------------------------
+
+template <class T>
+static void strOrder(std::vector<T>& v)
+      {
+      int n         = int(v.size());
+      int nodes     = (n + RTree::NODE_SIZE - 1) / RTree::NODE_SIZE;
+      int slices    = int(ceil(sqrt(qreal(nodes))));
+      int sliceSize = slices * RTree::NODE_SIZE;
+
+      std::sort(v.begin(), v.end(), [](const T& a, const T& b) {
+            return a.box.left() + a.box.right() < b.box.left() + b.box.right();
+            });
+      for (int i = 0; i < n; i += sliceSize) {
+            std::sort(v.begin() + i, v.begin() + qMin(i + sliceSize, n), [](const T& a, const T& b) {
+                  return a.box.top() + a.box.bottom() < b.box.top() + b.box.bottom();
+                  });
+            }
+      }
+
+//---------------------------------------------------------
+//   group
+//    create the parent level for consecutive runs of
+//    NODE_SIZE items
+//---------------------------------------------------------
+
+template <class T, class Node>
+static void group(const std::vector<T>& v, std::vector<Node>* parents)
+      {
+      int n = int(v.size());
+      parents->reserve((n + RTree::NODE_SIZE - 1) / RTree::NODE_SIZE);
+      for (int i = 0; i < n; i += RTree::NODE_SIZE) {
+            Node node;
+            node.first = i;
+            node.count = qMin(RTree::NODE_SIZE, n - i);
+            node.box   = v[i].box;
+            for (int k = 1; k < node.count; ++k)
+                  node.box = unite(node.box, v[i + k].box);
+            parents->push_back(node);
+            }
+      }
+
+//---------------------------------------------------------
+//   build
+//---------------------------------------------------------
+
+void RTree::build(const std::vector<Element*>& elements)
+      {
+      clear();
+      _entries.reserve(elements.size());
+      for (Element* e : elements) {
+            if (_index.contains(e))
+                  continue;
+            _index.insert(e, 0);
+            _entries.push_back({ e->pageBoundingRect(), e });
+            }
+      _packed = int(_entries.size());
+      if (_entries.empty())
+            return;
+
+      strOrder(_entries);
+      for (int i = 0; i < _packed; ++i)
+            _index[_entries[i].element] = i;
+
+      _levels.emplace_back();
+      group(_entries, &_levels.back());
+      while (_levels.back().size() > 1) {
+            // reordering a level keeps the child ranges of its nodes valid
+            strOrder(_levels.back());
+            std::vector<Node> upper;
+            group(_levels.back(), &upper);
+            _levels.push_back(std::move(upper));
+            }
+
+      _entryLeaf.resize(_packed);
+      for (int leaf = 0; leaf < int(_levels[0].size()); ++leaf) {
+            const Node& node = _levels[0][leaf];
+            for (int i = node.first; i < node.first + node.count; ++i)
+                  _entryLeaf[i] = leaf;
+            }
+      _parents.resize(_levels.size());
+      for (int level = 1; level < int(_levels.size()); ++level) {
+            _parents[level - 1].resize(_levels[level - 1].size());
+            for (int i = 0; i < int(_levels[level].size()); ++i) {
+                  const Node& node = _levels[level][i];
+                  for (int k = node.first; k < node.first + node.count; ++k)
+                        _parents[level - 1][k] = i;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void RTree::clear()
+      {
+      _entries.clear();
+      _levels.clear();
+      _parents.clear();
+      _entryLeaf.clear();
+      _index.clear();
+      _packed = 0;
+      _stale  = 0;
+      }
+
+//---------------------------------------------------------
+//   insert
+//    add an element created after the bulk load
+//---------------------------------------------------------
+
+void RTree::insert(Element* e)
+      {
+      if (_index.contains(e)) {
+            update(e);
+            return;
+            }
+      _index.insert(e, int(_entries.size()));
+      _entries.push_back({ e->pageBoundingRect(), e });
+      ++_stale;
+      }
+
+//---------------------------------------------------------
+//   update
+//    refresh the box of an element which has moved
+//---------------------------------------------------------
+
+void RTree::update(Element* e)
+      {
+      auto i = _index.find(e);
+      if (i == _index.end()) {
+            insert(e);
+            return;
+            }
+      int idx    = i.value();
+      QRectF box = e->pageBoundingRect();
+      _entries[idx].box = box;
+      if (idx >= _packed)
+            return;
+
+      int node = _entryLeaf[idx];
+      int n    = int(_levels.size());
+      for (int level = 0; level < n; ++level) {
+            QRectF& nb = _levels[level][node].box;
+            QRectF u   = unite(nb, box);
+            if (u == nb)
+                  break;
+            if (level == 0)
+                  ++_stale;
+            nb = u;
+            if (level + 1 < n)
+                  node = _parents[level][node];
+            }
+      }
+
+//---------------------------------------------------------
+//   findItems
+//---------------------------------------------------------
+
+void RTree::findItems(int level, int idx, const QRectF& r, std::vector<Element*>* out) const
+      {
+      const Node& node = _levels[level][idx];
+      if (level == 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                  const Entry& entry = _entries[i];
+                  if (overlaps(entry.box, r) && entry.element->pageBoundingRect().intersects(r))
+                        out->push_back(entry.element);
+                  }
+            return;
+            }
+      const std::vector<Node>& children = _levels[level - 1];
+      for (int i = node.first; i < node.first + node.count; ++i) {
+            if (overlaps(children[i].box, r))
+                  findItems(level - 1, i, r, out);
+            }
+      }
+
+void RTree::findItems(int level, int idx, const QPointF& p, std::vector<Element*>* out) const
+      {
+      const Node& node = _levels[level][idx];
+      if (level == 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                  const Entry& entry = _entries[i];
+                  if (covers(entry.box, p) && entry.element->contains(p))
+                        out->push_back(entry.element);
+                  }
+            return;
+            }
+      const std::vector<Node>& children = _levels[level - 1];
+      for (int i = node.first; i < node.first + node.count; ++i) {
+            if (covers(children[i].box, p))
+                  findItems(level - 1, i, p, out);
+            }
+      }
+
+//---------------------------------------------------------
+//   items
+//    append all elements whose page bounding rectangle
+//    intersects r to out; out is not cleared
+//---------------------------------------------------------
+
+void RTree::items(const QRectF& r, std::vector<Element*>* out) const
+      {
+      if (!_levels.empty() && overlaps(_levels.back()[0].box, r))
+            findItems(int(_levels.size()) - 1, 0, r, out);
+      for (int i = _packed; i < int(_entries.size()); ++i) {
+            Element* e = _entries[i].element;
+            if (e->pageBoundingRect().intersects(r))
+                  out->push_back(e);
+            }
+      }
+
+//---------------------------------------------------------
+//   items
+//    append all elements containing p to out
+//---------------------------------------------------------
+
+void RTree::items(const QPointF& p, std::vector<Element*>* out) const
+      {
+      if (!_levels.empty() && covers(_levels.back()[0].box, p))
+            findItems(int(_levels.size()) - 1, 0, p, out);
+      for (int i = _packed; i < int(_entries.size()); ++i) {
+            Element* e = _entries[i].element;
+            if (e->contains(p))
+                  out->push_back(e);
+            }
+      }
+
+QList<Element*> RTree::items(const QRectF& r) const
+      {
+      std::vector<Element*> v;
+      items(r, &v);
+      QList<Element*> l;
+      l.reserve(int(v.size()));
+      for (Element* e : v)
+            l.append(e);
+      return l;
+      }
+
+QList<Element*> RTree::items(const QPointF& p) const
+      {
+      std::vector<Element*> v;
+      items(p, &v);
+      QList<Element*> l;
+      l.reserve(int(v.size()));
+      for (Element* e : v)
+            l.append(e);
+      return l;
+      }
+
+}     // namespace Ms
@@ -0,0 +1,79 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __RTREE_H__
+#define __RTREE_H__
+
+namespace Ms {
+
+class Element;
+
+//---------------------------------------------------------
+//   RTree
+//    packed R-tree of page elements, bulk loaded with the
+//    sort-tile-recursive (STR) algorithm
+//
+//    Elements moved after the bulk load are updated in
+//    place by growing the boxes of their leaf and its
+//    ancestors; elements added later go to an overflow
+//    list which is searched linearly. needsRebuild() tells
+//    when the tree has degraded enough to be packed again.
+//---------------------------------------------------------
+
+class RTree
+      {
+   public:
+      static const int NODE_SIZE = 16;
+
+   private:
+      struct Entry {
+            QRectF box;
+            Element* element;
+            };
+      struct Node {
+            QRectF box;
+            int first;              // first child in the level below (or first entry)
+            int count;
+            };
+
+      std::vector<Entry> _entries;              // packed entries followed by the overflow list
+      int _packed { 0 };                        // number of entries covered by the tree
+      std::vector<std::vector<Node>> _levels;   // leaves first, root level last
+      std::vector<std::vector<int>> _parents;   // parent index of every node, per level
+      std::vector<int> _entryLeaf;              // leaf index of every packed entry
+      QHash<Element*, int> _index;              // element -> entry
+      int _stale { 0 };                         // entries grown or added since the bulk load
+
+      void findItems(int level, int node, const QRectF& r, std::vector<Element*>* out) const;
+      void findItems(int level, int node, const QPointF& p, std::vector<Element*>* out) const;
+
+   public:
+      RTree() {}
+
+      void build(const std::vector<Element*>& elements);
+      void clear();
+
+      void insert(Element*);
+      void update(Element*);
+
+      void items(const QRectF& r, std::vector<Element*>* out) const;
+      void items(const QPointF& p, std::vector<Element*>* out) const;
+      QList<Element*> items(const QRectF& r) const;
+      QList<Element*> items(const QPointF& p) const;
+
+      int size() const          { return int(_index.size()); }
+      int depth() const         { return int(_levels.size()); }
+      bool needsRebuild() const { return _stale * 4 > _packed + NODE_SIZE; }
+      };
+
+}     // namespace Ms
+#endif
@@ -309,6 +309,7 @@ Score::~Score()
       qDeleteAll(_parts);
       qDeleteAll(_staves);
       qDeleteAll(_systems);
+      qDeleteAll(_freeSystems);
       qDeleteAll(_pages);
       _masterScore = 0;
       }
@@ -1196,7 +1197,10 @@ static void updateStyle(void*, Element* e)
 
 void Score::styleChanged()
       {
+      if (_style.changed(StyleIdx::spatium) || _style.changed(StyleIdx::MusicalSymbolFont))
+            _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
       scanElements(0, updateStyle);
+      _style.clearChanged();
       setLayoutAll();
       }
 
@@ -3026,6 +3030,7 @@ void Score::lassoSelect(const QRectF& bbox)
       {
       select(0, SelectType::SINGLE, 0);
       QRectF fr(bbox.normalized());
+      std::vector<Element*> el;
       foreach(Page* page, _pages) {
             QRectF pr(page->bbox());
             QRectF frr(fr.translated(-page->pos()));
@@ -3034,9 +3039,9 @@ void Score::lassoSelect(const QRectF& bbox)
             if (pr.left() > frr.right())
                   break;
 
-            QList<Element*> el = page->items(frr);
-            for (int i = 0; i < el.size(); ++i) {
-                  Element* e = el.at(i);
+            el.clear();
+            page->items(frr, &el);
+            for (Element* e : el) {
                   if (frr.contains(e->abbox())) {
                         if (e->type() != Element::Type::MEASURE && e->selectable())
                               select(e, SelectType::ADD, 0);
@@ -4207,7 +4212,9 @@ void Score::setStyle(const MStyle& s)
       {
       if (style()->value(StyleIdx::spatium) != s.value(StyleIdx::spatium))
             spatiumChanged(style()->value(StyleIdx::spatium).toDouble(), s.value(StyleIdx::spatium).toDouble());
+      MStyle old = _style;
       _style = s;
+      _style.setChanged(old);
       }
 
 //---------------------------------------------------------
@@ -28,6 +28,7 @@
 #include "spannermap.h"
 #include "rehearsalmark.h"
 #include "tremolo.h"
+#include "velo.h"
 
 class QPainter;
 
@@ -264,14 +265,19 @@ class CmdState {
       UpdateMode _updateMode { UpdateMode::DoNothing };
       int _startTick {-1};            // start tick for mode LayoutTick
       int _endTick   {-1};              // end tick for mode LayoutTick
+      int _playStartTick {-1};          // range with changed play events only
+      int _playEndTick   {-1};
 
    public:
       LayoutFlags layoutFlags;
 
       bool _excerptsChanged     { false };
       bool _instrumentsChanged  { false };
+      bool _renderChanged       { false };  // changes which need only a repaint
 
       void reset();
+      void restoreLayout(const CmdState&);
+      bool rangeOnly() const;
       UpdateMode updateMode() const { return _updateMode; }
       void setUpdateMode(UpdateMode m);
       void _setUpdateMode(UpdateMode m) { _updateMode = m; }
@@ -282,6 +288,10 @@ class CmdState {
       void setTick(int t);
       int startTick() const    { return _startTick; }
       int endTick() const      { return _endTick; }
+      void setPlayTick(int t);
+      bool playRange() const   { return _playStartTick != -1; }
+      int playStartTick() const { return _playStartTick; }
+      int playEndTick() const  { return _playEndTick; }
       };
 
 class UpdateState {
@@ -367,6 +377,12 @@ class Score : public QObject, public ScoreElement {
             FILE_IGNORE_ERROR
             };
 
+      struct LayoutStats {
+            int layouts { 0 };      // calls of doLayout() and doLayoutRange()
+            int systems { 0 };      // systems collected
+            int concurrent { 0 };   // layouts on the thread pool, see layoutScores()
+            };
+
    private:
       int _linkId { 0 };
       MasterScore* _masterScore;
@@ -398,6 +414,7 @@ class Score : public QObject, public ScoreElement {
       //
       QList<Page*> _pages;          // pages are build from systems
       QList<System*> _systems;      // measures are akkumulated to systems
+      QList<System*> _freeSystems;  // obsolete systems, reused by getNextSystem()
 
       InputState _is;
       MStyle _style;
@@ -413,8 +430,12 @@ class Score : public QObject, public ScoreElement {
       bool _markIrregularMeasures { true  };
       bool _showInstrumentNames   { true  };
       bool _showVBox              { true  };
-      bool _printing              { false };      ///< True if we are drawing to a printer
       bool _playlistDirty         { true  };
+      bool _playAllDirty          { true  };      ///< next updateMidi() has to render all events
+      int _playDirtyTick1         { -1 };         ///< tick range changed since last updateMidi()
+      int _playDirtyTick2         { -1 };
+      QVector<qintptr> _playSignature;            ///< global playback state at last updateMidi()
+      QList<VeloList> _playVelocities;            ///< staff velocities at last updateMidi()
       bool _autosaveDirty         { true  };
       bool _saved                 { false };    ///< True if project was already saved; only on first
                                                 ///< save a backup file will be created, subsequent
@@ -471,6 +492,7 @@ class Score : public QObject, public ScoreElement {
       Page* addPage();
       bool layoutSystem(qreal& minWidth, qreal w, bool, bool);
       void createMMRest(Measure*, Measure*, const Fraction&);
+      void createMMRests();
       bool layoutSystem1(qreal& minWidth, bool, bool);
       QList<System*> layoutSystemRow(qreal w, bool, bool);
       System* getNextSystem(LayoutContext&);
@@ -506,6 +528,7 @@ class Score : public QObject, public ScoreElement {
    protected:
       int _fileDivision; ///< division of current loading *.msc file
       LayoutMode _layoutMode { LayoutMode::PAGE };
+      LayoutStats _layoutStats;
       SynthesizerState _synthesizerState;
 
       void createPlayEvents(Chord*);
@@ -761,12 +784,14 @@ class Score : public QObject, public ScoreElement {
       bool created() const           { return _created;       }
       bool saved() const             { return _saved;         }
       void setSaved(bool v)          { _saved = v;            }
-      bool printing() const          { return _printing;      }
-      void setPrinting(bool val)     { _printing = val;      }
+      bool printing() const          { return MScore::renderContext().printing; }
       void setAutosaveDirty(bool v)  { _autosaveDirty = v;    }
       bool autosaveDirty() const     { return _autosaveDirty; }
       bool playlistDirty()           { return _playlistDirty; }
       void setPlaylistDirty()        { _playlistDirty = true; }
+      void setPlayAllDirty()         { _playAllDirty = true;  }
+      bool playAllDirty() const      { return _playAllDirty;  }
+      void setPlayRangeDirty(int tick1, int tick2);
 
       void spell();
       void spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment);
@@ -780,12 +805,12 @@ class Score : public QObject, public ScoreElement {
       bool saveStyle(const QString&);
 
       QVariant style(StyleIdx idx) const   { return _style.value(idx);   }
-      Spatium  styleS(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return _style.value(idx).value<Spatium>();  }
+      Spatium  styleS(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return _style.svalue(idx);  }
       qreal    styleP(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return _style.pvalue(idx); }
       QString  styleSt(StyleIdx idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"QString")); return _style.value(idx).toString(); }
-      bool     styleB(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool")); return _style.value(idx).toBool();  }
-      qreal    styleD(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double")); return _style.value(idx).toDouble();  }
-      int      styleI(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int")); return _style.value(idx).toInt();  }
+      bool     styleB(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool")); return _style.bvalue(idx);  }
+      qreal    styleD(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double")); return _style.dvalue(idx);  }
+      int      styleI(StyleIdx idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int")); return _style.ivalue(idx);  }
 
       const TextStyle& textStyle(TextStyleType idx) const { return _style.textStyle(idx); }
       const TextStyle& textStyle(const QString& s) const  { return _style.textStyle(s); }
@@ -829,8 +854,11 @@ class Score : public QObject, public ScoreElement {
       PasteState pasteStaff(XmlReader&, Segment* dst, int staffIdx);
       void pasteSymbols(XmlReader& e, ChordRest* dst);
       void renderMidi(EventMap* events);
-      void renderStaff(EventMap* events, Staff*);
+      void updateMidi(EventMap* events);
+      void renderStaff(EventMap* events, Staff*, int tick1 = 0, int tick2 = -1);
+      void renderStaves(EventMap* events);
       void renderSpanners(EventMap* events, int staffIdx);
+      void renderMetronome(EventMap* events);
       void renderMetronome(EventMap* events, Measure* m, int tickOffset);
 
       BeatType tick2beatType(int tick);
@@ -842,6 +870,7 @@ class Score : public QObject, public ScoreElement {
 
       void updateSwing();
       void createPlayEvents();
+      void createPlayEvents(Measure* start, Measure* end);
 
       void cmdConcertPitchChanged(bool, bool /*useSharpsFlats*/);
 
@@ -894,6 +923,7 @@ class Score : public QObject, public ScoreElement {
       QList<Page*>& pages()                    { return _pages;                }
       const QList<System*>& systems() const    { return _systems;              }
       QList<System*>& systems()                { return _systems;              }
+      const QList<System*>& freeSystems() const { return _freeSystems;        }
 
       MeasureBaseList* measures()             { return &_measures; }
       bool checkHasMeasures() const;
@@ -938,6 +968,7 @@ class Score : public QObject, public ScoreElement {
 
       void doLayout();
       void doLayoutRange(int, int);
+      static void layoutScores(const QList<Score*>&);
       void layoutLinear(LayoutContext& lc);
 
       void layoutSystemsUndoRedo();
@@ -995,6 +1026,8 @@ class Score : public QObject, public ScoreElement {
 
       LayoutMode layoutMode() const         { return _layoutMode; }
       void setLayoutMode(LayoutMode lm)     { _layoutMode = lm;   }
+      const LayoutStats& layoutStats() const { return _layoutStats; }
+      void resetLayoutStats()               { _layoutStats = LayoutStats(); }
 
       bool floatMode() const                { return layoutMode() == LayoutMode::FLOAT; }
       bool pageMode() const                 { return layoutMode() == LayoutMode::PAGE; }
@@ -483,8 +483,9 @@ QImage Score::createThumbnail()
       pm.setDotsPerMeterY(dpm);
       pm.fill(0xffffffff);
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = 1.0;
+      RenderContext ctx;
+      ctx.pixelRatio = 1.0;
+      RenderScope scope(ctx);
 
       QPainter p(&pm);
       p.setRenderHint(QPainter::Antialiasing, true);
@@ -493,8 +494,6 @@ QImage Score::createThumbnail()
       print(&p, 0);
       p.end();
 
-      MScore::pixelRatio = pr;
-
       if (layoutMode() != mode) {
             setLayoutMode(mode);
             doLayout();
@@ -937,8 +936,11 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
 
 void Score::print(QPainter* painter, int pageNo)
       {
-      _printing  = true;
-      MScore::pdfPrinting = true;
+      RenderContext ctx = MScore::renderContext();
+      ctx.printing = true;
+      ctx.pdf      = true;
+      RenderScope scope(ctx);
+
       Page* page = pages().at(pageNo);
       QRectF fr  = page->abbox();
 
@@ -952,8 +954,6 @@ void Score::print(QPainter* painter, int pageNo)
             e->draw(painter);
             painter->restore();
             }
-      MScore::pdfPrinting = false;
-      _printing = false;
       }
 
 //---------------------------------------------------------
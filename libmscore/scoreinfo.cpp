@@ -0,0 +1,239 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "scoreinfo.h"
+#include "xml.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+
+namespace Ms {
+
+extern QString readRootFile(MQZipReader*, QList<QString>&);
+
+//---------------------------------------------------------
+//   read
+//---------------------------------------------------------
+
+Score::FileError ScoreInfo::read(const QString& path, Facets facets)
+      {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly)) {
+            MScore::lastError = f.errorString();
+            return Score::FileError::FILE_OPEN_ERROR;
+            }
+      return read(path, &f, facets);
+      }
+
+Score::FileError ScoreInfo::read(const QString& path, QIODevice* io, Facets facets)
+      {
+      _facets = facets;
+      bool needXml = facets & (Facet::META | Facet::PARTS | Facet::MEASURES);
+
+      if (!path.endsWith(".mscz")) {
+            if (!needXml)
+                  return Score::FileError::FILE_NO_ERROR;
+            XmlReader e(io, path);
+            return readXml(e);
+            }
+
+      // only the entries needed are decompressed
+      MQZipReader uz(io);
+      if (facets & Facet::THUMBNAIL) {
+            QByteArray ba = uz.fileData("Thumbnails/thumbnail.png");
+            if (!ba.isEmpty())
+                  _thumbnail.loadFromData(ba, "PNG");
+            }
+      if (!needXml)
+            return Score::FileError::FILE_NO_ERROR;
+
+      QList<QString> images;
+      QString rootfile = readRootFile(&uz, images);
+      if (rootfile.isEmpty())
+            return Score::FileError::FILE_NO_ROOTFILE;
+      QByteArray dbuf = uz.fileData(rootfile);
+      if (dbuf.isEmpty()) {
+            for (const MQZipReader::FileInfo& fi : uz.fileInfoList()) {
+                  if (fi.filePath.endsWith(".mscx")) {
+                        dbuf = uz.fileData(fi.filePath);
+                        break;
+                        }
+                  }
+            }
+      XmlReader e(dbuf, path);
+      return readXml(e);
+      }
+
+//---------------------------------------------------------
+//   done
+//    meta tags and parts are written before the staves,
+//    the measure facet only needs the first staff
+//---------------------------------------------------------
+
+bool ScoreInfo::done() const
+      {
+      return _staffRead;
+      }
+
+//---------------------------------------------------------
+//   readXml
+//---------------------------------------------------------
+
+Score::FileError ScoreInfo::readXml(XmlReader& e)
+      {
+      while (e.readNextStartElement()) {
+            if (e.name() == "museScore") {
+                  QStringList sl = e.attribute("version").split('.');
+                  if (sl.size() == 2)
+                        _mscVersion = sl[0].toInt() * 100 + sl[1].toInt();
+                  // 1.14 files have no <Score> element
+                  readScore(e);
+                  if (!done() && e.hasError())
+                        return Score::FileError::FILE_BAD_FORMAT;
+                  return Score::FileError::FILE_NO_ERROR;
+                  }
+            else
+                  e.unknown();
+            }
+      return Score::FileError::FILE_CORRUPTED;
+      }
+
+//---------------------------------------------------------
+//   readScore
+//    read <museScore> or <Score>
+//---------------------------------------------------------
+
+void ScoreInfo::readScore(XmlReader& e)
+      {
+      bool master = e.name() == "museScore";
+      while (e.readNextStartElement()) {
+            const QStringRef& tag(e.name());
+            if (tag == "programVersion")
+                  _programVersion = e.readElementText();
+            else if (tag == "Score" && master) {
+                  readScore(e);
+                  if (done())
+                        return;
+                  }
+            else if (tag == "metaTag") {
+                  QString name = e.attribute("name");
+                  _metaTags.insert(name, e.readElementText());
+                  }
+            else if (tag == "movement-number")
+                  _metaTags.insert("movementNumber", e.readElementText());
+            else if (tag == "movement-title")
+                  _metaTags.insert("movementTitle", e.readElementText());
+            else if (tag == "work-number")
+                  _metaTags.insert("workNumber", e.readElementText());
+            else if (tag == "work-title")
+                  _metaTags.insert("workTitle", e.readElementText());
+            else if (tag == "source")
+                  _metaTags.insert("source", e.readElementText());
+            else if (tag == "Part" && (_facets & Facet::PARTS))
+                  readPart(e);
+            else if (tag == "Staff") {
+                  if (_facets & Facet::MEASURES)
+                        readFirstStaff(e);
+                  _staffRead = true;
+                  return;
+                  }
+            else
+                  e.skipCurrentElement();
+            }
+      }
+
+//---------------------------------------------------------
+//   readPart
+//---------------------------------------------------------
+
+void ScoreInfo::readPart(XmlReader& e)
+      {
+      PartInfo pi;
+      while (e.readNextStartElement()) {
+            const QStringRef& tag(e.name());
+            if (tag == "Staff") {
+                  ++pi.staves;
+                  e.skipCurrentElement();
+                  }
+            else if (tag == "show")
+                  pi.show = e.readInt();
+            else if (tag == "trackName")
+                  pi.name = e.readElementText();
+            else if (tag == "Instrument") {
+                  while (e.readNextStartElement()) {
+                        const QStringRef& t(e.name());
+                        if (t == "longName" && pi.longName.isEmpty()) {
+                              QString s = e.readXml();
+                              if (s.startsWith("<html>"))
+                                    s = QTextDocumentFragment::fromHtml(s).toPlainText();
+                              pi.longName = s;
+                              }
+                        else if (t == "instrumentId")
+                              pi.instrumentId = e.readElementText();
+                        else
+                              e.skipCurrentElement();
+                        }
+                  }
+            else
+                  e.skipCurrentElement();
+            }
+      _parts.append(pi);
+      }
+
+//---------------------------------------------------------
+//   readFirstStaff
+//    count the measures and collect key and time
+//    signature changes
+//---------------------------------------------------------
+
+void ScoreInfo::readFirstStaff(XmlReader& e)
+      {
+      int measure = 0;
+      while (e.readNextStartElement()) {
+            if (e.name() != "Measure") {
+                  e.skipCurrentElement();
+                  continue;
+                  }
+            while (e.readNextStartElement()) {
+                  const QStringRef& tag(e.name());
+                  if (tag == "KeySig") {
+                        int key = 0;
+                        while (e.readNextStartElement()) {
+                              if (e.name() == "accidental")
+                                    key = e.readInt();
+                              else
+                                    e.skipCurrentElement();
+                              }
+                        if (_keys.empty() || _keys.last().key != key)
+                              _keys.append({ measure, key });
+                        }
+                  else if (tag == "TimeSig") {
+                        int n = 0;
+                        int d = 0;
+                        while (e.readNextStartElement()) {
+                              if (e.name() == "sigN")
+                                    n = e.readInt();
+                              else if (e.name() == "sigD")
+                                    d = e.readInt();
+                              else
+                                    e.skipCurrentElement();
+                              }
+                        if (_timeSigs.empty() || _timeSigs.last().numerator != n || _timeSigs.last().denominator != d)
+                              _timeSigs.append({ measure, n, d });
+                        }
+                  else
+                        e.skipCurrentElement();
+                  }
+            ++measure;
+            }
+      _measures = measure;
+      }
+
+}     // namespace Ms
@@ -0,0 +1,95 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SCOREINFO_H__
+#define __SCOREINFO_H__
+
+#include "score.h"
+
+namespace Ms {
+
+class XmlReader;
+
+//---------------------------------------------------------
+//   ScoreInfo
+//    Reads selected facets of a .mscx/.mscz file without
+//    building a Score. The xml is streamed and everything
+//    not needed for the requested facets is skipped;
+//    reading stops as soon as all facets are complete.
+//    Images, audio and excerpts are never loaded.
+//---------------------------------------------------------
+
+class ScoreInfo {
+   public:
+      enum class Facet : char {
+            META      = 1,        // program version and meta tags
+            PARTS     = 2,        // parts and instruments
+            MEASURES  = 4,        // measure count, key and time signature changes
+            THUMBNAIL = 8,        // embedded thumbnail (.mscz only)
+            ALL       = 0xf
+            };
+      typedef QFlags<Facet> Facets;
+
+      struct PartInfo {
+            QString name;
+            QString longName;
+            QString instrumentId;
+            int staves { 0 };
+            bool show  { true };
+            };
+      struct KeyChange {
+            int measure;          // measure index, 0 based
+            int key;              // number of sharps (>0) or flats (<0)
+            };
+      struct TimeSigChange {
+            int measure;
+            int numerator;
+            int denominator;
+            };
+
+   private:
+      Facets _facets;
+      int _mscVersion { 0 };
+      QString _programVersion;
+      QMap<QString, QString> _metaTags;
+      QList<PartInfo> _parts;
+      int _measures { 0 };
+      QList<KeyChange> _keys;
+      QList<TimeSigChange> _timeSigs;
+      QImage _thumbnail;
+      bool _staffRead { false };
+
+      bool done() const;
+      Score::FileError readXml(XmlReader&);
+      void readScore(XmlReader&);
+      void readPart(XmlReader&);
+      void readFirstStaff(XmlReader&);
+
+   public:
+      ScoreInfo() {}
+      Score::FileError read(const QString& path, Facets facets = Facet::ALL);
+      Score::FileError read(const QString& path, QIODevice*, Facets facets = Facet::ALL);
+
+      int mscVersion() const                       { return _mscVersion;     }
+      const QString& programVersion() const        { return _programVersion; }
+      const QMap<QString, QString>& metaTags() const { return _metaTags;     }
+      const QList<PartInfo>& parts() const         { return _parts;          }
+      int measures() const                         { return _measures;       }
+      const QList<KeyChange>& keys() const         { return _keys;           }
+      const QList<TimeSigChange>& timeSigs() const { return _timeSigs;       }
+      const QImage& thumbnail() const              { return _thumbnail;      }
+      };
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ScoreInfo::Facets);
+
+}     // namespace Ms
+#endif
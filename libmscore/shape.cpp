@@ -15,14 +15,102 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   lessY
+//    sort order of the top edges, NaN sorts last
+//---------------------------------------------------------
+
+static inline bool lessY(qreal a, qreal b)
+      {
+      return !std::isnan(a) && (std::isnan(b) || a < b);
+      }
+
+//---------------------------------------------------------
+//   insertPos
+//    index for a new rectangle with top edge y
+//---------------------------------------------------------
+
+int Shape::insertPos(qreal y) const
+      {
+      return int(std::upper_bound(_y.begin(), _y.end(), y, lessY) - _y.begin());
+      }
+
+//---------------------------------------------------------
+//   append
+//    append rectangle idx of s, keeps sort order only if
+//    called in sort order
+//---------------------------------------------------------
+
+void Shape::append(const Shape& s, int idx)
+      {
+      _x.push_back(s._x[idx]);
+      _y.push_back(s._y[idx]);
+      _w.push_back(s._w[idx]);
+      _h.push_back(s._h[idx]);
+      }
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void Shape::add(const QRectF& r)
+      {
+      int i = insertPos(r.y());
+      _x.insert(_x.begin() + i, r.x());
+      _y.insert(_y.begin() + i, r.y());
+      _w.insert(_w.begin() + i, r.width());
+      _h.insert(_h.begin() + i, r.height());
+      }
+
+void Shape::add(const Shape& s)
+      {
+      if (s.empty())
+            return;
+      if (&s == this) {
+            Shape c(s);
+            add(c);
+            return;
+            }
+      if (empty() || !lessY(s._y.front(), _y.back())) {
+            _x.insert(_x.end(), s._x.begin(), s._x.end());
+            _y.insert(_y.end(), s._y.begin(), s._y.end());
+            _w.insert(_w.end(), s._w.begin(), s._w.end());
+            _h.insert(_h.end(), s._h.begin(), s._h.end());
+            return;
+            }
+      // merge both sorted lists
+      Shape m;
+      int n  = size();
+      int ns = s.size();
+      m._x.reserve(n + ns);
+      m._y.reserve(n + ns);
+      m._w.reserve(n + ns);
+      m._h.reserve(n + ns);
+      int i = 0;
+      int k = 0;
+      while (i < n || k < ns) {
+            if (k == ns || (i < n && !lessY(s._y[k], _y[i])))
+                  m.append(*this, i++);
+            else
+                  m.append(s, k++);
+            }
+      *this = std::move(m);
+      }
+
 //---------------------------------------------------------
 //   translate
+//    keeps the sort order
 //---------------------------------------------------------
 
 void Shape::translate(const QPointF& pt)
       {
-      for (QRectF& r : *this)
-            r.translate(pt);
+      qreal dx = pt.x();
+      qreal dy = pt.y();
+      int n    = size();
+      for (int i = 0; i < n; ++i)
+            _x[i] += dx;
+      for (int i = 0; i < n; ++i)
+            _y[i] += dy;
       }
 
 //---------------------------------------------------------
@@ -31,9 +119,8 @@ void Shape::translate(const QPointF& pt)
 
 Shape Shape::translated(const QPointF& pt) const
       {
-      Shape s;
-      for (const QRectF& r : *this)
-            s.add(r.translated(pt));
+      Shape s(*this);
+      s.translate(pt);
       return s;
       }
 
@@ -45,11 +132,52 @@ Shape Shape::translated(const QPointF& pt) const
 void Shape::draw(QPainter* p) const
       {
       p->save();
-      for (const QRectF& r : *this)
-            p->drawRect(r);
+      for (int i = 0; i < size(); ++i)
+            p->drawRect(rect(i));
       p->restore();
       }
 
+//---------------------------------------------------------
+//   IntervalIndex
+//    rectangles of a shape sorted by the start of one of
+//    their intervals; used to find all rectangles whose
+//    interval can intersect a given interval
+//---------------------------------------------------------
+
+struct IntervalIndex {
+      const qreal* start;     // sorted, without NaN
+      const qreal* len;
+      int n;
+      qreal maxLen;           // largest positive length, 0 if none
+
+      IntervalIndex(const qreal* s, const qreal* l, int size)
+         : start(s), len(l), n(size), maxLen(0.0)
+            {
+            for (int i = 0; i < n; ++i) {
+                  if (len[i] > maxLen)
+                        maxLen = len[i];
+                  }
+            }
+
+      //---------------------------------------------------
+      //    range
+      //    [lo, hi) contains all intervals [start, start+len)
+      //    for which intersects(c1, c2, start, start+len)
+      //    can be true: start < c2 and start + len > c1.
+      //    Addition is monotone, so start + maxLen > c1
+      //    holds for every such interval.
+      //---------------------------------------------------
+
+      void range(qreal c1, qreal c2, int* lo, int* hi) const
+            {
+            qreal ml = maxLen;
+            *lo = int(std::partition_point(start, start + n, [c1, ml](qreal v) { return !(v + ml > c1); }) - start);
+            *hi = int(std::lower_bound(start + *lo, start + n, c2) - start);
+            }
+      };
+
+static const int BRUTE_FORCE_PAIRS = 64;  // below this all pairs are compared
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -60,17 +188,77 @@ void Shape::draw(QPainter* p) const
 qreal Shape::minHorizontalDistance(const Shape& a) const
       {
       qreal dist = -1000000.0;      // min real
-      for (const QRectF& r2 : a) {
-            qreal by1 = r2.top();
-            qreal by2 = r2.bottom();
-            for (const QRectF& r1 : *this) {
-                  qreal ay1 = r1.top();
-                  qreal ay2 = r1.bottom();
-//                  if (intersects(ay1, ay2, by1, by2))
-                  if (intersects(ay1, ay2, by1, by2)
-                     || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
-                     || ((r1.width() == 0.0) || (r2.width() == 0.0)))
-                        dist = qMax(dist, r1.right() - r2.left());
+      int n  = size();
+      int na = a.size();
+      if (n == 0 || na == 0)
+            return dist;
+
+      if (n * na <= BRUTE_FORCE_PAIRS) {
+            for (int k = 0; k < na; ++k) {
+                  qreal by1 = a._y[k];
+                  qreal by2 = by1 + a._h[k];
+                  for (int i = 0; i < n; ++i) {
+                        qreal ay1 = _y[i];
+                        qreal ay2 = ay1 + _h[i];
+                        if (intersects(ay1, ay2, by1, by2)
+                           || ((_h[i] == 0.0) && (a._h[k] == 0.0) && (ay1 == by1))
+                           || ((_w[i] == 0.0) || (a._w[k] == 0.0)))
+                              dist = qMax(dist, (_x[i] + _w[i]) - a._x[k]);
+                        }
+                  }
+            return dist;
+            }
+
+      // Subtraction is monotone: the largest right - left over all
+      // partners of a zero width rectangle is right - (smallest left)
+      // resp. (largest right) - left. NaN values never win in qMax.
+
+      qreal maxRight = -std::numeric_limits<qreal>::infinity();
+      for (int i = 0; i < n; ++i) {
+            qreal r = _x[i] + _w[i];
+            if (r > maxRight)
+                  maxRight = r;
+            }
+      qreal minLeft = std::numeric_limits<qreal>::infinity();
+      for (int k = 0; k < na; ++k) {
+            if (a._x[k] < minLeft)
+                  minLeft = a._x[k];
+            }
+      for (int i = 0; i < n; ++i) {
+            if (_w[i] == 0.0)
+                  dist = qMax(dist, (_x[i] + _w[i]) - minLeft);
+            }
+      for (int k = 0; k < na; ++k) {
+            if (a._w[k] == 0.0)
+                  dist = qMax(dist, maxRight - a._x[k]);
+            }
+
+      int nya = int(std::partition_point(a._y.begin(), a._y.end(), [](qreal v) { return !std::isnan(v); }) - a._y.begin());
+
+      // zero height rectangles at the same y position
+      for (int i = 0; i < n; ++i) {
+            if (_h[i] != 0.0 || std::isnan(_y[i]))
+                  continue;
+            auto r = std::equal_range(a._y.begin(), a._y.begin() + nya, _y[i]);
+            for (auto k = r.first - a._y.begin(); k < r.second - a._y.begin(); ++k) {
+                  if (a._h[k] == 0.0)
+                        dist = qMax(dist, (_x[i] + _w[i]) - a._x[k]);
+                  }
+            }
+
+      // overlapping y intervals
+      IntervalIndex index(a._y.data(), a._h.data(), nya);
+      for (int i = 0; i < n; ++i) {
+            qreal ay1 = _y[i];
+            qreal ay2 = ay1 + _h[i];
+            if (ay1 == ay2 || std::isnan(ay1) || std::isnan(ay2))
+                  continue;
+            qreal right = _x[i] + _w[i];
+            int lo, hi;
+            index.range(ay1, ay2, &lo, &hi);
+            for (int k = lo; k < hi; ++k) {
+                  if (intersects(ay1, ay2, a._y[k], a._y[k] + a._h[k]))
+                        dist = qMax(dist, right - a._x[k]);
                   }
             }
       return dist;
@@ -85,14 +273,55 @@ qreal Shape::minHorizontalDistance(const Shape& a) const
 qreal Shape::minVerticalDistance(const Shape& a) const
       {
       qreal dist = -1000000.0;      // min real
-      for (const QRectF& r2 : a) {
-            qreal bx1 = r2.left();
-            qreal bx2 = r2.right();
-            for (const QRectF& r1 : *this) {
-                  qreal ax1 = r1.left();
-                  qreal ax2 = r1.right();
-                  if (intersects(ax1, ax2, bx1, bx2))
-                        dist = qMax(dist, r1.bottom() - r2.top());
+      int n  = size();
+      int na = a.size();
+      if (n == 0 || na == 0)
+            return dist;
+
+      if (n * na <= BRUTE_FORCE_PAIRS) {
+            for (int k = 0; k < na; ++k) {
+                  qreal bx1 = a._x[k];
+                  qreal bx2 = bx1 + a._w[k];
+                  for (int i = 0; i < n; ++i) {
+                        qreal ax1 = _x[i];
+                        qreal ax2 = ax1 + _w[i];
+                        if (intersects(ax1, ax2, bx1, bx2))
+                              dist = qMax(dist, (_y[i] + _h[i]) - a._y[k]);
+                        }
+                  }
+            return dist;
+            }
+
+      // shapes are sorted by y, sort the rectangles of a by x
+      std::vector<int> order;
+      order.reserve(na);
+      for (int k = 0; k < na; ++k) {
+            if (!std::isnan(a._x[k]))
+                  order.push_back(k);
+            }
+      std::sort(order.begin(), order.end(), [&a](int k1, int k2) { return a._x[k1] < a._x[k2]; });
+      int nxa = int(order.size());
+      std::vector<qreal> x(nxa);
+      std::vector<qreal> w(nxa);
+      std::vector<qreal> top(nxa);
+      for (int k = 0; k < nxa; ++k) {
+            x[k]   = a._x[order[k]];
+            w[k]   = a._w[order[k]];
+            top[k] = a._y[order[k]];
+            }
+
+      IntervalIndex index(x.data(), w.data(), nxa);
+      for (int i = 0; i < n; ++i) {
+            qreal ax1 = _x[i];
+            qreal ax2 = ax1 + _w[i];
+            if (ax1 == ax2 || std::isnan(ax1) || std::isnan(ax2))
+                  continue;
+            qreal bottom = _y[i] + _h[i];
+            int lo, hi;
+            index.range(ax1, ax2, &lo, &hi);
+            for (int k = lo; k < hi; ++k) {
+                  if (intersects(ax1, ax2, x[k], x[k] + w[k]))
+                        dist = qMax(dist, bottom - top[k]);
                   }
             }
       return dist;
@@ -106,10 +335,10 @@ qreal Shape::minVerticalDistance(const Shape& a) const
 qreal Shape::left() const
       {
       qreal dist = 0.0;
-      for (const QRectF& r : *this) {
-            if (r.height() != 0.0 && r.left() < dist)
+      for (int i = 0; i < size(); ++i) {
+            if (_h[i] != 0.0 && _x[i] < dist)
             // if (r.left() < dist)
-                  dist = r.left();
+                  dist = _x[i];
             }
       return -dist;
       }
@@ -122,9 +351,10 @@ qreal Shape::left() const
 qreal Shape::right() const
       {
       qreal dist = 0.0;
-      for (const QRectF& r : *this) {
-            if (r.right() > dist)
-                  dist = r.right();
+      for (int i = 0; i < size(); ++i) {
+            qreal r = _x[i] + _w[i];
+            if (r > dist)
+                  dist = r;
             }
       return dist;
       }
@@ -136,9 +366,9 @@ qreal Shape::right() const
 qreal Shape::top() const
       {
       qreal dist = 0.0;
-      for (const QRectF& r : *this) {
-            if (r.top() < dist)
-                  dist = r.top();
+      for (int i = 0; i < size(); ++i) {
+            if (_y[i] < dist)
+                  dist = _y[i];
             }
       return dist;
       }
@@ -150,9 +380,10 @@ qreal Shape::top() const
 qreal Shape::bottom() const
       {
       qreal dist = 0.0;
-      for (const QRectF& r : *this) {
-            if (r.bottom() > dist)
-                  dist = r.bottom();
+      for (int i = 0; i < size(); ++i) {
+            qreal b = _y[i] + _h[i];
+            if (b > dist)
+                  dist = b;
             }
       return dist;
       }
@@ -166,9 +397,9 @@ qreal Shape::bottom() const
 qreal Shape::topDistance(const QPointF& p) const
       {
       qreal dist = 1000000.0;
-      for (const QRectF& r : *this) {
-            if (p.x() >= r.left() && p.x() < r.right())
-                  dist = qMin(dist, r.top() - p.y());
+      for (int i = 0; i < size(); ++i) {
+            if (p.x() >= _x[i] && p.x() < _x[i] + _w[i])
+                  dist = qMin(dist, _y[i] - p.y());
             }
       return dist;
       }
@@ -182,9 +413,9 @@ qreal Shape::topDistance(const QPointF& p) const
 qreal Shape::bottomDistance(const QPointF& p) const
       {
       qreal dist = 1000000.0;
-      for (const QRectF& r : *this) {
-            if (p.x() >= r.left() && p.x() < r.right())
-                  dist = qMin(dist, p.y() - r.bottom());
+      for (int i = 0; i < size(); ++i) {
+            if (p.x() >= _x[i] && p.x() < _x[i] + _w[i])
+                  dist = qMin(dist, p.y() - (_y[i] + _h[i]));
             }
       return dist;
       }
@@ -195,9 +426,12 @@ qreal Shape::bottomDistance(const QPointF& p) const
 
 void Shape::remove(const QRectF& r)
       {
-      for (auto i = begin(); i != end(); ++i) {
-            if (*i == r) {
-                  erase(i);
+      for (int i = 0; i < size(); ++i) {
+            if (rect(i) == r) {
+                  _x.erase(_x.begin() + i);
+                  _y.erase(_y.begin() + i);
+                  _w.erase(_w.begin() + i);
+                  _h.erase(_h.begin() + i);
                   return;
                   }
             }
@@ -206,8 +440,8 @@ void Shape::remove(const QRectF& r)
 
 void Shape::remove(const Shape& s)
       {
-      for (const QRectF& r : s)
-            remove(r);
+      for (int i = 0; i < s.size(); ++i)
+            remove(s.rect(i));
       }
 
 #ifdef DEBUG_SHAPES
@@ -219,9 +453,8 @@ void Shape::remove(const Shape& s)
 void Shape::dump(const char* p) const
       {
       printf("Shape dump: %p %s size %d\n", this, p, size());
-      for (const QRectF& r : *this) {
-            printf("   %f %f %f %f\n", r.x(), r.y(), r.width(), r.height());
-            }
+      for (int i = 0; i < size(); ++i)
+            printf("   %f %f %f %f\n", _x[i], _y[i], _w[i], _h[i]);
 
       }
 
@@ -23,16 +23,29 @@ class Segment;
 
 //---------------------------------------------------------
 //   Shape
+//    A set of rectangles, stored as separate coordinate
+//    arrays sorted by top edge (rectangles with NaN top
+//    last). The sort order lets the distance functions
+//    only look at rectangles which can overlap instead of
+//    comparing all pairs.
 //---------------------------------------------------------
 
-class Shape : std::vector<QRectF> {
+class Shape {
+      std::vector<qreal> _x;        // left
+      std::vector<qreal> _y;        // top, sorted
+      std::vector<qreal> _w;        // width
+      std::vector<qreal> _h;        // height
+
+      int insertPos(qreal y) const;
+      void append(const Shape& s, int idx);
+
    public:
       Shape() {}
       Shape(const QRectF& r) { add(r); }
       void draw(QPainter*) const;
 
-      void add(const Shape& s)            { insert(end(), s.begin(), s.end()); }
-      void add(const QRectF& r)           { push_back(r); }
+      void add(const Shape& s);
+      void add(const QRectF& r);
       void remove(const QRectF&);
       void remove(const Shape&);
       void translate(const QPointF&);
@@ -46,9 +59,10 @@ class Shape : std::vector<QRectF> {
       qreal top() const;
       qreal bottom() const;
 
-      int size() const   { return std::vector<QRectF>::size(); }
-      bool empty() const { return std::vector<QRectF>::empty(); }
-      void clear()       { std::vector<QRectF>::clear();       }
+      int size() const              { return int(_y.size()); }
+      bool empty() const            { return _y.empty();     }
+      void clear()                  { _x.clear(); _y.clear(); _w.clear(); _h.clear(); }
+      QRectF rect(int i) const      { return QRectF(_x[i], _y[i], _w[i], _h[i]); }
 
 #ifdef DEBUG_SHAPES
       void dump(const char*) const;
@@ -984,7 +984,7 @@ void TabDurationSymbol::draw(QPainter* painter) const
       if (_beamGrid == TabBeamGrid::NONE) {
             // if no beam grid, draw symbol
             QFont f(_tab->durationFont());
-            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+            f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
             painter->setFont(f);
             painter->drawText(QPointF(0.0, 0.0), _text);
             }
@@ -438,7 +438,8 @@ void initStyle(MStyle* s)
 //---------------------------------------------------------
 
 MStyle::MStyle()
-   : _values(int(StyleIdx::STYLES)), _precomputedValues(int(StyleIdx::STYLES))
+   : _values(int(StyleIdx::STYLES)), _realValues(int(StyleIdx::STYLES)),
+     _precomputedValues(int(StyleIdx::STYLES)), _intValues(int(StyleIdx::STYLES))
       {
       _customChordList = false;
       for (const StyleType& t : styleTypes)
@@ -446,6 +447,64 @@ MStyle::MStyle()
       precomputeValues();
       };
 
+//---------------------------------------------------------
+//   ValueKind
+//    storage class of a style value, computed once from
+//    the type of the default value
+//---------------------------------------------------------
+
+enum class ValueKind : char {
+      OTHER, SPATIUM, DOUBLE, BOOL, INT
+      };
+
+static ValueKind valueKind(int idx)
+      {
+      static const std::vector<ValueKind> kinds = [] {
+            std::vector<ValueKind> v(int(StyleIdx::STYLES), ValueKind::OTHER);
+            for (const StyleType& t : styleTypes) {
+                  const char* type = t.valueType();
+                  if (!strcmp(type, "Ms::Spatium"))
+                        v[t.idx()] = ValueKind::SPATIUM;
+                  else if (!strcmp(type, "double"))
+                        v[t.idx()] = ValueKind::DOUBLE;
+                  else if (!strcmp(type, "bool"))
+                        v[t.idx()] = ValueKind::BOOL;
+                  else if (!strcmp(type, "int"))
+                        v[t.idx()] = ValueKind::INT;
+                  }
+            return v;
+            }();
+      return kinds[idx];
+      }
+
+//---------------------------------------------------------
+//   setTypedValue
+//    mirror _values[idx] into the typed arrays
+//---------------------------------------------------------
+
+void MStyle::setTypedValue(int idx, qreal spatium)
+      {
+      const QVariant& v = _values[idx];
+      switch (valueKind(idx)) {
+            case ValueKind::SPATIUM:
+                  _realValues[idx]        = v.value<Spatium>().val();
+                  _precomputedValues[idx] = _realValues[idx] * spatium;
+                  break;
+            case ValueKind::DOUBLE:
+                  _realValues[idx]        = v.toDouble();
+                  _precomputedValues[idx] = _realValues[idx];
+                  break;
+            case ValueKind::BOOL:
+                  _intValues[idx] = v.toBool();
+                  break;
+            case ValueKind::INT:
+                  _intValues[idx] = v.toInt();
+                  break;
+            case ValueKind::OTHER:
+                  break;
+            }
+      }
+
 //---------------------------------------------------------
 //   precomputeValues
 //---------------------------------------------------------
@@ -453,10 +512,8 @@ MStyle::MStyle()
 void MStyle::precomputeValues()
       {
       qreal _spatium = value(StyleIdx::spatium).toDouble();
-      for (const StyleType& t : styleTypes) {
-            if (!strcmp(t.valueType(), "Ms::Spatium"))
-                  _precomputedValues[t.idx()] = _values[t.idx()].value<Spatium>().val() * _spatium;
-            }
+      for (int idx = 0; idx < int(StyleIdx::STYLES); ++idx)
+            setTypedValue(idx, _spatium);
       }
 
 //---------------------------------------------------------
@@ -498,7 +555,10 @@ void MStyle::setChordList(ChordList* cl, bool custom)
 MStyle::MStyle(const MStyle& s)
       {
       _values            = s._values;
+      _realValues        = s._realValues;
       _precomputedValues = s._precomputedValues;
+      _intValues         = s._intValues;
+      _changed           = s._changed;
       _chordList         = s._chordList;
       _textStyles        = s._textStyles;
       _pageFormat.copy(s._pageFormat);
@@ -508,7 +568,10 @@ MStyle::MStyle(const MStyle& s)
 MStyle& MStyle::operator=(const MStyle& s)
       {
       _values            = s._values;
+      _realValues        = s._realValues;
       _precomputedValues = s._precomputedValues;
+      _intValues         = s._intValues;
+      _changed           = s._changed;
       _chordList         = s._chordList;
       _textStyles        = s._textStyles;
       _pageFormat.copy(s._pageFormat);
@@ -605,15 +668,33 @@ const QList<TextStyle>& MStyle::textStyles() const
 void MStyle::set(const StyleIdx t, const QVariant& val)
       {
       const int idx = int(t);
+      if (_values[idx] == val)
+            return;
       _values[idx] = val;
-      if (t == StyleIdx::spatium)
-            precomputeValues();
-      else {
-            if (!strcmp(styleTypes[idx].valueType(), "Ms::Spatium")) {
-                  qreal _spatium = value(StyleIdx::spatium).toDouble();
-                  _precomputedValues[idx] = _values[idx].value<Spatium>().val() * _spatium;
+      _changed.set(idx);
+      if (t == StyleIdx::spatium) {
+            // only the spatium dependent values change
+            qreal _spatium = val.toDouble();
+            for (int i = 0; i < int(StyleIdx::STYLES); ++i) {
+                  if (valueKind(i) == ValueKind::SPATIUM)
+                        _precomputedValues[i] = _realValues[i] * _spatium;
                   }
             }
+      setTypedValue(idx, value(StyleIdx::spatium).toDouble());
+      }
+
+//---------------------------------------------------------
+//   setChanged
+//    record all values which differ from old, used when
+//    the whole style is replaced
+//---------------------------------------------------------
+
+void MStyle::setChanged(const MStyle& old)
+      {
+      for (int idx = 0; idx < int(StyleIdx::STYLES); ++idx) {
+            if (_values[idx] != old._values[idx])
+                  _changed.set(idx);
+            }
       }
 
 //---------------------------------------------------------
@@ -13,6 +13,8 @@
 #ifndef __STYLE_H__
 #define __STYLE_H__
 
+#include <bitset>
+
 #include "mscore.h"
 #include "spatium.h"
 #include "articulation.h"
@@ -314,11 +316,26 @@ struct StyleType {
 
 //---------------------------------------------------------
 //   MStyle
+//    Every value is kept as QVariant for read/write and the
+//    ui, and mirrored into typed arrays so the accessors used
+//    by layout are plain loads:
+//       Spatium: raw value in _realValues, value * spatium
+//                in _precomputedValues
+//       double:  _realValues and _precomputedValues
+//       bool, int: _intValues
+//
+//    set() records which values actually changed. Caches
+//    which depend on some style values can ask changed()
+//    and only invalidate what is affected;
+//    Score::styleChanged() clears the record.
 //---------------------------------------------------------
 
 class MStyle {
       QVector<QVariant> _values;
+      QVector<qreal> _realValues;
       QVector<qreal> _precomputedValues;
+      QVector<int> _intValues;
+      std::bitset<size_t(StyleIdx::STYLES)> _changed;
 
       ChordList _chordList;
       QList<TextStyle> _textStyles;
@@ -327,6 +344,7 @@ class MStyle {
       bool _customChordList;        // if true, chordlist will be saved as part of score
 
       void precomputeValues();
+      void setTypedValue(int idx, qreal spatium);
 
    public:
       MStyle();
@@ -355,6 +373,15 @@ class MStyle {
 
       QVariant value(StyleIdx idx) const  { return _values[int(idx)]; }
       qreal pvalue(StyleIdx idx) const    { return _precomputedValues[int(idx)]; }
+      Spatium svalue(StyleIdx idx) const  { return Spatium(_realValues[int(idx)]); }
+      qreal dvalue(StyleIdx idx) const    { return _realValues[int(idx)]; }
+      bool bvalue(StyleIdx idx) const     { return _intValues[int(idx)]; }
+      int ivalue(StyleIdx idx) const      { return _intValues[int(idx)]; }
+
+      bool changed(StyleIdx idx) const    { return _changed.test(size_t(idx)); }
+      bool changed() const                { return _changed.any(); }
+      void setChanged(const MStyle& old);
+      void clearChanged()                 { _changed.reset(); }
 
       bool load(QFile* qf);
       void load(XmlReader& e);
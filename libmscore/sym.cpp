@@ -17,6 +17,8 @@
 #include "xml.h"
 #include "mscore.h"
 
+#include <QtCore/QCryptographicHash>
+
 #include FT_GLYPH_H
 #include FT_IMAGE_H
 #include FT_BBOX_H
@@ -41,6 +43,7 @@ QVector<ScoreFont> ScoreFont::_scoreFonts {
       };
 
 QJsonObject ScoreFont::_glyphnamesJson;
+QByteArray ScoreFont::_glyphnamesData;
 
 //---------------------------------------------------------
 //   table of symbol names
@@ -5600,7 +5603,153 @@ SymId Sym::userName2id(const QString& s)
 bool GlyphKey::operator==(const GlyphKey& k) const
       {
       return (face == k.face) && (id == k.id)
-         && (mag == k.mag) && (worldScale == k.worldScale) && (color == k.color);
+         && (mag == k.mag) && (worldScale == k.worldScale);
+      }
+
+//---------------------------------------------------------
+//   GlyphCache
+//---------------------------------------------------------
+
+static const int GLYPH_CACHE_DEFAULT_BYTES = 16 * 1024 * 1024;
+
+GlyphCache* GlyphCache::instance()
+      {
+      static GlyphCache cache(GLYPH_CACHE_DEFAULT_BYTES);
+      return &cache;
+      }
+
+//---------------------------------------------------------
+//   tint
+//---------------------------------------------------------
+
+QImage GlyphCache::tint(const QImage& mask, QRgb color)
+      {
+      QImage img(mask.size(), QImage::Format_ARGB32_Premultiplied);
+      img.setDevicePixelRatio(mask.devicePixelRatio());
+      int r = qRed(color);
+      int g = qGreen(color);
+      int b = qBlue(color);
+      for (int y = 0; y < mask.height(); ++y) {
+            const uchar* src = mask.constScanLine(y);
+            QRgb* dst        = reinterpret_cast<QRgb*>(img.scanLine(y));
+            for (int x = 0; x < mask.width(); ++x)
+                  *dst++ = qPremultiply(qRgba(r, g, b, *src++));
+            }
+      return img;
+      }
+
+//---------------------------------------------------------
+//   find
+//    on a hit, return the glyph tinted with color; a glyph
+//    whose mask is cached but not yet tinted with color is
+//    tinted without holding the lock
+//---------------------------------------------------------
+
+bool GlyphCache::find(const GlyphKey& key, QRgb color, QImage* image, QPointF* offset)
+      {
+      TintKey tk(key, color);
+      QMutexLocker locker(&_mutex);
+      Glyph* g = _tinted.object(tk);
+      if (g) {
+            ++_hits;
+            *image  = g->image;
+            *offset = g->offset;
+            return true;
+            }
+      g = _masks.object(key);
+      if (!g) {
+            ++_misses;
+            return false;
+            }
+      ++_hits;
+      QImage mask = g->image;
+      *offset     = g->offset;
+      locker.unlock();
+
+      *image = tint(mask, color);
+
+      locker.relock();
+      insertTinted(tk, *image, *offset);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   insert
+//    mask must be Format_Alpha8; return the glyph tinted
+//    with color in image
+//---------------------------------------------------------
+
+void GlyphCache::insert(const GlyphKey& key, const QImage& mask, const QPointF& offset, QRgb color, QImage* image)
+      {
+      *image = tint(mask, color);
+
+      QMutexLocker locker(&_mutex);
+      ++_inserts;
+      _masks.insert(key, new Glyph { mask, offset }, mask.byteCount());   // deletes the glyph if it exceeds the budget
+      insertTinted(TintKey(key, color), *image, offset);
+      }
+
+//---------------------------------------------------------
+//   insertTinted
+//    called with the lock held
+//---------------------------------------------------------
+
+void GlyphCache::insertTinted(const TintKey& key, const QImage& image, const QPointF& offset)
+      {
+      ++_inserts;
+      _tinted.insert(key, new Glyph { image, offset }, image.byteCount());
+      }
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void GlyphCache::clear()
+      {
+      QMutexLocker locker(&_mutex);
+      _inserts -= _masks.count() + _tinted.count();
+      _masks.clear();
+      _tinted.clear();
+      }
+
+//---------------------------------------------------------
+//   maxBytes
+//---------------------------------------------------------
+
+int GlyphCache::maxBytes() const
+      {
+      QMutexLocker locker(&_mutex);
+      return _masks.maxCost() + _tinted.maxCost();
+      }
+
+//---------------------------------------------------------
+//   setMaxBytes
+//---------------------------------------------------------
+
+void GlyphCache::setMaxBytes(int val)
+      {
+      QMutexLocker locker(&_mutex);
+      _masks.setMaxCost(val / 4);
+      _tinted.setMaxCost(val - val / 4);
+      }
+
+//---------------------------------------------------------
+//   stats
+//    entries and bytes cover the masks and the tinted
+//    glyphs
+//---------------------------------------------------------
+
+GlyphCache::Stats GlyphCache::stats() const
+      {
+      QMutexLocker locker(&_mutex);
+      Stats st;
+      st.hits      = _hits;
+      st.misses    = _misses;
+      st.evictions = _inserts - _masks.count() - _tinted.count();
+      st.entries   = _masks.count() + _tinted.count();
+      st.bytes     = _masks.totalCost() + _tinted.totalCost();
+      st.maxBytes  = _masks.maxCost() + _tinted.maxCost();
+      return st;
       }
 
 //---------------------------------------------------------
@@ -5626,13 +5775,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
                   qDebug("ScoreFont::draw: invalid sym %d", int(id));
             return;
             }
-      int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-      if (rv) {
-            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-            return;
-            }
-
-      if (MScore::pdfPrinting) {
+      if (MScore::pdfPrinting()) {
             if (font == 0) {
                   QString s(_fontPath+_filename);
                   if (-1 == QFontDatabase::addApplicationFont(s)) {
@@ -5645,7 +5788,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
                   font->setFamily(_family);
                   font->setStyleStrategy(QFont::NoFontMerging);
                   font->setHintingPreference(QFont::PreferVerticalHinting);
-                  qreal size = 20.0 * MScore::pixelRatio;
+                  qreal size = 20.0 * MScore::pixelRatio();
                   font->setPointSize(size);
                   }
             qreal imag = 1.0 / mag;
@@ -5656,18 +5799,28 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
             return;
             }
 
-      QColor color(painter->pen().color());
+      QRgb color = painter->pen().color().rgb();
 
       int pr           = painter->device()->devicePixelRatio();
       qreal pixelRatio = qreal(pr > 0 ? pr : 1);
       worldScale      *= pixelRatio;
 //      if (worldScale < 1.0)
 //            worldScale = 1.0;
-      int scale16      = lrint(worldScale * 6553.6 * mag * DPI_F);
 
-      GlyphKey gk(face, id, mag, worldScale, color);
-      GlyphPixmap* pm = cache->object(gk);
-      if (!pm) {
+      GlyphKey gk(face, id, mag, worldScale);
+      QImage img;
+      QPointF offset;
+      if (!GlyphCache::instance()->find(gk, color, &img, &offset)) {
+            // FreeType faces must not be used concurrently
+            static QMutex ftMutex;
+            QMutexLocker locker(&ftMutex);
+
+            int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+            if (rv) {
+                  qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+                  return;
+                  }
+            int scale16 = lrint(worldScale * 6553.6 * mag * DPI_F);
             FT_Matrix matrix {
                   scale16, 0,
                   0,       scale16
@@ -5679,6 +5832,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
             rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
             if (rv) {
                   qDebug("glyph to bitmap failed: 0x%x", rv);
+                  FT_Done_Glyph(glyph);
                   return;
                   }
 
@@ -5687,29 +5841,18 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
 
             if (bm->width == 0 || bm->rows == 0) {
                   qDebug("zero glyph");
+                  FT_Done_Glyph(glyph);
                   return;
                   }
-            QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-            img.fill(Qt::transparent);
-
-            for (int y = 0; y < int(bm->rows); ++y) {
-                  unsigned* dst      = (unsigned*)img.scanLine(y);
-                  unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-                  for (int x = 0; x < int(bm->width); ++x) {
-                        unsigned val = *src++;
-                        color.setAlpha(val);
-                        *dst++ = color.rgba();
-                        }
-                  }
-            pm = new GlyphPixmap;
-            pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-            pm->pm.setDevicePixelRatio(worldScale);
-            pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-            if (!cache->insert(gk, pm))
-                  qDebug("cannot cache glyph");
+            QImage mask(QSize(bm->width, bm->rows), QImage::Format_Alpha8);
+            for (int y = 0; y < int(bm->rows); ++y)
+                  memcpy(mask.scanLine(y), bm->buffer + bm->pitch * y, bm->width);
+            mask.setDevicePixelRatio(worldScale);
+            offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
             FT_Done_Glyph(glyph);
+            GlyphCache::instance()->insert(gk, mask, offset, color, &img);
             }
-      painter->drawPixmap(pos + pm->offset, pm->pm);
+      painter->drawImage(pos + offset, img);
       }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -5833,11 +5976,127 @@ void ScoreFont::load()
             qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
             return;
             }
-      cache = new QCache<GlyphKey, GlyphPixmap>(100);
-
       qreal pixelSize = 200.0;
       FT_Set_Pixel_Sizes(face, 0, int(pixelSize+.5));
 
+      QFile fi(_fontPath + "metadata.json");
+      if (!fi.open(QIODevice::ReadOnly))
+            qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+      QByteArray metadata = fi.readAll();
+
+      QCryptographicHash h(QCryptographicHash::Md5);
+      h.addData(fontImage);
+      h.addData(metadata);
+      h.addData(_glyphnamesData);
+      QByteArray key = h.result();
+
+      if (!readMetricsCache(key)) {
+            loadMetrics(metadata, fi.fileName());
+            writeMetricsCache(key);
+            }
+      _engravingDefaults.push_back(std::make_pair(StyleIdx::MusicalTextFont, QString("%1 Text").arg(_family)));
+
+      // create missing composed glyphs
+      struct Composed {
+            SymId id;
+            std::vector<SymId> rids;
+            } composed[] = {
+
+            { SymId::ornamentPrallMordent,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  } },
+            { SymId::ornamentUpPrall,
+                  {
+                  SymId::ornamentBottomLeftConcaveStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentUpMordent,
+                  {
+                  SymId::ornamentBottomLeftConcaveStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentPrallDown,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentBottomRightConcaveStroke,
+                  }},
+            { SymId::ornamentDownPrall,
+                  {
+                  SymId::ornamentLeftVerticalStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentDownMordent,
+                  {
+                  SymId::ornamentLeftVerticalStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentMiddleVerticalStroke,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }},
+            { SymId::ornamentPrallUp,
+                  {
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentTopRightConvexStroke,
+                  }},
+            { SymId::ornamentLinePrall,
+                  {
+                  SymId::ornamentLeftVerticalStroke,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineNoRightEnd,
+                  SymId::ornamentZigZagLineWithRightEnd
+                  }}
+            };
+
+      for (const Composed& c : composed) {
+            if (!_symbols[int(c.id)].isValid()) {
+                  Sym* sym = &_symbols[int(c.id)];
+                  std::vector<SymId> s;
+                  for (SymId id : c.rids)
+                        s.push_back(id);
+                  sym->setSymList(s);
+                  sym->setBbox(bbox(s, 1.0));
+                  }
+            }
+
+#if 0
+      //
+      // check for missing symbols
+      //
+      ScoreFont* fb = ScoreFont::fallbackFont();
+      if (fb && fb != this) {
+            for (int i = 1; i < int(SymId::lastSym); ++i) {
+                  const Sym& sym = _symbols[i];
+                  if (!sym.isValid()) {
+                        qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
+                        }
+                  }
+            }
+#endif
+      }
+
+//---------------------------------------------------------
+//   loadMetrics
+//    compute symbol metrics with FreeType and read
+//    anchors and engraving defaults from the font metadata
+//---------------------------------------------------------
+
+void ScoreFont::loadMetrics(const QByteArray& metadata, const QString& metadataPath)
+      {
       for (auto i : ScoreFont::glyphNamesJson().keys()) {
             bool ok;
             int code = ScoreFont::glyphNamesJson().value(i).toObject().value("codepoint").toString().mid(2).toInt(&ok, 16);
@@ -5853,12 +6112,9 @@ void ScoreFont::load()
             }
 
       QJsonParseError error;
-      QFile fi(_fontPath + "metadata.json");
-      if (!fi.open(QIODevice::ReadOnly))
-            qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-      QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+      QJsonObject metadataJson = QJsonDocument::fromJson(metadata, &error).object();
       if (error.error != QJsonParseError::NoError)
-            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(metadataPath),
                error.offset, qPrintable(error.errorString()));
 
       QJsonObject oo = metadataJson.value("glyphsWithAnchors").toObject();
@@ -5869,7 +6125,7 @@ void ScoreFont::load()
             if (symId == SymId::noSym) {
                   // currently, Bravura contains a bunch of entries in glyphsWithAnchors
                   // for glyph names that will not be found - flag32ndUpStraight, etc.
-                  //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(fi.fileName()));
+                  //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(metadataPath));
                   continue;
                   }
             Sym* sym = &_symbols[int(symId)];
@@ -5939,85 +6195,6 @@ void ScoreFont::load()
                         _textEnclosureThickness = oo.value(i).toDouble();
                   }
             }
-      _engravingDefaults.push_back(std::make_pair(StyleIdx::MusicalTextFont, QString("%1 Text").arg(_family)));
-
-      // create missing composed glyphs
-      struct Composed {
-            SymId id;
-            std::vector<SymId> rids;
-            } composed[] = {
-
-            { SymId::ornamentPrallMordent,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  } },
-            { SymId::ornamentUpPrall,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentUpMordent,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallDown,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentBottomRightConcaveStroke,
-                  }},
-            { SymId::ornamentDownPrall,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentDownMordent,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallUp,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentTopRightConvexStroke,
-                  }},
-            { SymId::ornamentLinePrall,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }}
-            };
-
-      for (const Composed& c : composed) {
-            if (!_symbols[int(c.id)].isValid()) {
-                  Sym* sym = &_symbols[int(c.id)];
-                  std::vector<SymId> s;
-                  for (SymId id : c.rids)
-                        s.push_back(id);
-                  sym->setSymList(s);
-                  sym->setBbox(bbox(s, 1.0));
-                  }
-            }
-
       // access needed stylistic alternates
 
       struct StylisticAlternate {
@@ -6112,20 +6289,165 @@ void ScoreFont::load()
       // add space symbol
       Sym* sym = &_symbols[int(SymId::space)];
       computeMetrics(sym, 32);
-#if 0
-      //
-      // check for missing symbols
-      //
-      ScoreFont* fb = ScoreFont::fallbackFont();
-      if (fb && fb != this) {
-            for (int i = 1; i < int(SymId::lastSym); ++i) {
-                  const Sym& sym = _symbols[i];
-                  if (!sym.isValid()) {
-                        qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
-                        }
+      }
+
+//---------------------------------------------------------
+//   metrics cache
+//    Binary image of everything loadMetrics() computes,
+//    one file per font, stored in the cache location and
+//    keyed by a hash of the font file, its metadata and the
+//    glyph names. The layout is host specific; a file with a
+//    wrong magic, version or key is ignored and rewritten.
+//---------------------------------------------------------
+
+static const char metricsCacheMagic[8] = { 'M', 'S', 'S', 'Y', 'M', 'C', 'C', '\0' };
+static const quint32 METRICS_CACHE_VERSION = 1;
+
+struct MetricsCacheHeader {
+      char magic[8];
+      quint32 version;
+      quint32 symbols;
+      quint32 engravingDefaults;
+      quint32 dpi;
+      char key[16];
+      double textEnclosureThickness;
+      };
+
+struct MetricsCacheSym {
+      qint32 code;
+      quint32 index;
+      double bbox[4];
+      double advance;
+      double anchors[12];     // stemDownNW, stemUpSE, cutOutNE, cutOutNW, cutOutSE, cutOutSW
+      };
+
+struct MetricsCacheDefault {
+      qint32 idx;
+      qint32 reserved;
+      double value;
+      };
+
+//---------------------------------------------------------
+//   metricsCachePath
+//---------------------------------------------------------
+
+QString ScoreFont::metricsCachePath() const
+      {
+      QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+      if (dir.isEmpty())
+            return QString();
+      return dir + "/symbols/" + _name.toLower() + ".symcache";
+      }
+
+//---------------------------------------------------------
+//   readMetricsCache
+//    return false if there is no valid cache for key
+//---------------------------------------------------------
+
+bool ScoreFont::readMetricsCache(const QByteArray& key)
+      {
+      QString path = metricsCachePath();
+      if (path.isEmpty() || key.size() != sizeof(MetricsCacheHeader::key))
+            return false;
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly) || f.size() < qint64(sizeof(MetricsCacheHeader)))
+            return false;
+      const uchar* data = f.map(0, f.size());
+      if (!data)
+            return false;
+
+      MetricsCacheHeader h;
+      memcpy(&h, data, sizeof(h));
+      qint64 size = sizeof(h) + qint64(h.symbols) * sizeof(MetricsCacheSym)
+         + qint64(h.engravingDefaults) * sizeof(MetricsCacheDefault);
+      if (memcmp(h.magic, metricsCacheMagic, sizeof(h.magic))
+         || h.version != METRICS_CACHE_VERSION
+         || h.symbols != quint32(_symbols.size())
+         || h.dpi != quint32(DPI)
+         || memcmp(h.key, key.constData(), sizeof(h.key))
+         || f.size() != size) {
+            f.unmap(const_cast<uchar*>(data));
+            return false;
+            }
+
+      const MetricsCacheSym* ms = reinterpret_cast<const MetricsCacheSym*>(data + sizeof(h));
+      for (int i = 0; i < _symbols.size(); ++i, ++ms) {
+            Sym* sym = &_symbols[i];
+            sym->_code       = ms->code;
+            sym->_index      = ms->index;
+            sym->_bbox       = QRectF(ms->bbox[0], ms->bbox[1], ms->bbox[2], ms->bbox[3]);
+            sym->_advance    = ms->advance;
+            sym->_stemDownNW = QPointF(ms->anchors[0],  ms->anchors[1]);
+            sym->_stemUpSE   = QPointF(ms->anchors[2],  ms->anchors[3]);
+            sym->_cutOutNE   = QPointF(ms->anchors[4],  ms->anchors[5]);
+            sym->_cutOutNW   = QPointF(ms->anchors[6],  ms->anchors[7]);
+            sym->_cutOutSE   = QPointF(ms->anchors[8],  ms->anchors[9]);
+            sym->_cutOutSW   = QPointF(ms->anchors[10], ms->anchors[11]);
+            }
+      const MetricsCacheDefault* md = reinterpret_cast<const MetricsCacheDefault*>(ms);
+      for (quint32 i = 0; i < h.engravingDefaults; ++i, ++md)
+            _engravingDefaults.push_back(std::make_pair(StyleIdx(md->idx), QVariant(md->value)));
+      _textEnclosureThickness = h.textEnclosureThickness;
+
+      f.unmap(const_cast<uchar*>(data));
+      return true;
+      }
+
+//---------------------------------------------------------
+//   writeMetricsCache
+//---------------------------------------------------------
+
+void ScoreFont::writeMetricsCache(const QByteArray& key) const
+      {
+      QString path = metricsCachePath();
+      if (path.isEmpty() || key.size() != sizeof(MetricsCacheHeader::key))
+            return;
+      if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+            return;
+
+      MetricsCacheHeader h;
+      memset(&h, 0, sizeof(h));
+      memcpy(h.magic, metricsCacheMagic, sizeof(h.magic));
+      h.version           = METRICS_CACHE_VERSION;
+      h.symbols           = _symbols.size();
+      h.engravingDefaults = _engravingDefaults.size();
+      h.dpi               = DPI;
+      memcpy(h.key, key.constData(), sizeof(h.key));
+      h.textEnclosureThickness = _textEnclosureThickness;
+
+      QByteArray data(reinterpret_cast<const char*>(&h), sizeof(h));
+      for (const Sym& sym : _symbols) {
+            MetricsCacheSym ms;
+            memset(&ms, 0, sizeof(ms));
+            ms.code    = sym._code;
+            ms.index   = sym.isValid() ? sym._index : 0;
+            ms.bbox[0] = sym._bbox.x();
+            ms.bbox[1] = sym._bbox.y();
+            ms.bbox[2] = sym._bbox.width();
+            ms.bbox[3] = sym._bbox.height();
+            ms.advance = sym.isValid() ? sym._advance : 0.0;
+            const QPointF anchors[] = { sym._stemDownNW, sym._stemUpSE, sym._cutOutNE,
+                                        sym._cutOutNW, sym._cutOutSE, sym._cutOutSW };
+            for (int i = 0; i < 6; ++i) {
+                  ms.anchors[i * 2]     = anchors[i].x();
+                  ms.anchors[i * 2 + 1] = anchors[i].y();
                   }
+            data.append(reinterpret_cast<const char*>(&ms), sizeof(ms));
             }
-#endif
+      for (const auto& d : _engravingDefaults) {
+            MetricsCacheDefault md;
+            md.idx      = int(d.first);
+            md.reserved = 0;
+            md.value    = d.second.toDouble();
+            data.append(reinterpret_cast<const char*>(&md), sizeof(md));
+            }
+
+      QSaveFile f(path);
+      if (!f.open(QIODevice::WriteOnly))
+            return;
+      f.write(data);
+      if (!f.commit())
+            qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
       }
 
 //---------------------------------------------------------
@@ -6177,6 +6499,8 @@ const char* ScoreFont::fallbackTextFont()
 
 //---------------------------------------------------------
 //   initGlyphNamesJson
+//    read glyphnames.json; it is parsed only if the
+//    metrics of a font have to be computed
 //---------------------------------------------------------
 
 bool ScoreFont::initGlyphNamesJson()
@@ -6186,17 +6510,28 @@ bool ScoreFont::initGlyphNamesJson()
             qDebug("ScoreFont: open glyph names file <%s> failed", qPrintable(fi.fileName()));
             return false;
             }
-      QJsonParseError error;
-      _glyphnamesJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
-      if (error.error != QJsonParseError::NoError) {
-            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
-               error.offset, qPrintable(error.errorString()));
-            return false;
-            }
+      _glyphnamesData = fi.readAll();
+      _glyphnamesJson = QJsonObject();
       fi.close();
       return true;
       }
 
+//---------------------------------------------------------
+//   glyphNamesJson
+//---------------------------------------------------------
+
+const QJsonObject& ScoreFont::glyphNamesJson()
+      {
+      if (_glyphnamesJson.isEmpty() && !_glyphnamesData.isEmpty()) {
+            QJsonParseError error;
+            _glyphnamesJson = QJsonDocument::fromJson(_glyphnamesData, &error).object();
+            if (error.error != QJsonParseError::NoError)
+                  qDebug("Json parse error in <glyphnames.json>(offset: %d): %s",
+                     error.offset, qPrintable(error.errorString()));
+            }
+      return _glyphnamesJson;
+      }
+
 //---------------------------------------------------------
 //   useFallbackFont
 //---------------------------------------------------------
@@ -6297,12 +6632,10 @@ ScoreFont::ScoreFont(const ScoreFont& f)
       _filename = f._filename;
 
       // fontImage;
-      cache = 0;
       }
 
 ScoreFont::~ScoreFont()
       {
-      delete cache;
       }
 }
 
@@ -2744,24 +2744,92 @@ struct GlyphKey {
       SymId id;
       qreal mag;
       qreal worldScale;
-      QColor color;
 
    public:
-      GlyphKey(FT_Face _f, SymId _id, float m, float s, QColor c)
-         : face(_f), id(_id), mag(m), worldScale(s), color(c) {}
+      GlyphKey(FT_Face _f, SymId _id, qreal m, qreal s)
+         : face(_f), id(_id), mag(m), worldScale(s) {}
       bool operator==(const GlyphKey&) const;
       };
 
-struct GlyphPixmap {
-      QPixmap pm;
-      QPointF offset;
+inline uint qHash(const GlyphKey& k, uint seed = 0)
+      {
+      uint h = ::qHash(quintptr(k.face), seed);
+      h = 31 * h + ::qHash(int(k.id), seed);
+      h = 31 * h + ::qHash(k.mag, seed);
+      h = 31 * h + ::qHash(k.worldScale, seed);
+      return h;
+      }
+
+//---------------------------------------------------------
+//   TintKey
+//    a glyph in a color
+//---------------------------------------------------------
+
+struct TintKey {
+      GlyphKey glyph;
+      QRgb color;
+
+   public:
+      TintKey(const GlyphKey& g, QRgb c) : glyph(g), color(c) {}
+      bool operator==(const TintKey& k) const { return glyph == k.glyph && color == k.color; }
       };
 
-inline uint qHash(const GlyphKey& k)
+inline uint qHash(const TintKey& k, uint seed = 0)
       {
-      return (int(k.id) << 16) + k.mag;
+      return 31 * qHash(k.glyph, seed) + ::qHash(k.color, seed);
       }
 
+//---------------------------------------------------------
+//   GlyphCache
+//    Rendered glyphs of all score fonts, shared by all
+//    views and threads. Glyphs are stored as alpha masks;
+//    the masks tinted with a pen color are cached
+//    separately for every color in use, so alternating
+//    colors (selection) do not tint again on every draw.
+//    Tinting is done outside of the cache lock. Both
+//    caches share a byte budget, a quarter of it for the
+//    masks.
+//---------------------------------------------------------
+
+class GlyphCache {
+   public:
+      struct Stats {
+            quint64 hits      { 0 };
+            quint64 misses    { 0 };
+            quint64 evictions { 0 };
+            int entries       { 0 };
+            int bytes         { 0 };
+            int maxBytes      { 0 };
+            };
+
+   private:
+      struct Glyph {
+            QImage image;           // Format_Alpha8 mask or tinted ARGB32_Premultiplied
+            QPointF offset;
+            };
+      QCache<GlyphKey, Glyph> _masks;
+      QCache<TintKey, Glyph> _tinted;
+      mutable QMutex _mutex;
+      quint64 _hits    { 0 };
+      quint64 _misses  { 0 };
+      quint64 _inserts { 0 };
+
+      static QImage tint(const QImage& mask, QRgb color);
+      void insertTinted(const TintKey&, const QImage&, const QPointF&);
+
+   public:
+      GlyphCache(int maxBytes) : _masks(maxBytes / 4), _tinted(maxBytes - maxBytes / 4) {}
+      bool find(const GlyphKey&, QRgb color, QImage* image, QPointF* offset);
+      void insert(const GlyphKey&, const QImage& mask, const QPointF& offset, QRgb color, QImage* image);
+      void clear();
+
+      int maxBytes() const;
+      void setMaxBytes(int);
+      Stats stats() const;
+
+      static GlyphCache* instance();
+      };
+
 //---------------------------------------------------------
 //   ScoreFont
 //---------------------------------------------------------
@@ -2774,16 +2842,20 @@ class ScoreFont {
       QString _fontPath;
       QString _filename;
       QByteArray fontImage;
-      QCache<GlyphKey, GlyphPixmap>* cache { 0 };
       std::list<std::pair<StyleIdx, QVariant>> _engravingDefaults;
       double _textEnclosureThickness = 0;
       mutable QFont* font { 0 };
 
       static QVector<ScoreFont> _scoreFonts;
       static QJsonObject _glyphnamesJson;
+      static QByteArray _glyphnamesData;     // raw glyphnames.json, parsed on demand
       const Sym& sym(SymId id) const { return _symbols[int(id)]; }
       void load();
+      void loadMetrics(const QByteArray& metadata, const QString& metadataPath);
       void computeMetrics(Sym* sym, int code);
+      QString metricsCachePath() const;
+      bool readMetricsCache(const QByteArray& key);
+      void writeMetricsCache(const QByteArray& key) const;
 
    public:
       ScoreFont() {}
@@ -2806,7 +2878,7 @@ class ScoreFont {
       static const char* fallbackTextFont();
       static const QVector<ScoreFont>& scoreFonts() { return _scoreFonts; }
       static bool initGlyphNamesJson();
-      static const QJsonObject& glyphNamesJson() { return _glyphnamesJson; }
+      static const QJsonObject& glyphNamesJson();
 
       QString toString(SymId) const;
       QPixmap sym2pixmap(SymId, qreal) { return QPixmap(); }      // TODOxxxx
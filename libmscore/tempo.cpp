@@ -113,6 +113,10 @@ void TempoMap::normalize()
             tick  = e->first;
             tempo = e->second.tempo;
             }
+      _timeIndex.clear();
+      _timeIndex.reserve(size());
+      for (auto e = begin(); e != end(); ++e)
+            _timeIndex.push_back({ e->second.time, e->second.pause, e->second.tempo, e->first });
       ++_tempoSN;
       }
 
@@ -135,6 +139,7 @@ void TempoMap::dump() const
 void TempoMap::clear()
       {
       std::map<int,TEvent>::clear();
+      _timeIndex.clear();
       ++_tempoSN;
       }
 
@@ -262,28 +267,30 @@ qreal TempoMap::tick2time(int tick, int* sn) const
 
 //---------------------------------------------------------
 //   time2tick
+//    Event times are monotonic, so the event which ends the
+//    search is the first one at or after time. If time falls
+//    into the pause of that event, the result is the tick where
+//    the pause starts.
 //---------------------------------------------------------
 
 int TempoMap::time2tick(qreal time, int* sn) const
       {
-      int tick     = 0;
-      qreal delta = time;
-      qreal tempo = _tempo;
+      Q_ASSERT(_timeIndex.size() == size());
+      int tick    = 0;
+      qreal delta = 0.0;
+      qreal tempo = 2.0;
 
-      delta = 0.0;
-      tempo = 2.0;
-      for (auto e = begin(); e != end(); ++e) {
-            // if in a pause period, wait on previous tick
-            if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-                  delta = (time - (e->second.time - e->second.pause) + delta);
-                  break;
-                  }
-            if (e->second.time >= time)
-                  break;
-            delta = e->second.time;
-            tick  = e->first;
-            tempo = e->second.tempo;
+      auto e = std::lower_bound(_timeIndex.begin(), _timeIndex.end(), time,
+         [](const TimeIndexEntry& i, qreal t) { return i.time < t; });
+      if (e != _timeIndex.begin()) {
+            auto pe = e - 1;
+            delta = pe->time;
+            tick  = pe->tick;
+            tempo = pe->tempo;
             }
+      // if in a pause period, wait on previous tick
+      if (e != _timeIndex.end() && (time > e->time - e->pause))
+            delta = time - (e->time - e->pause) + delta;
       delta = time - delta;
       tick += lrint(delta * _relTempo * MScore::division * tempo);
       if (sn)
@@ -47,6 +47,20 @@ class TempoMap : public std::map<int, TEvent> {
       qreal _tempo;           // tempo if not using tempo list (beats per second)
       qreal _relTempo;        // rel. tempo
 
+      //---------------------------------------------------
+      //   TimeIndexEntry
+      //    copy of the map in time order, rebuilt by
+      //    normalize() for binary search in time2tick()
+      //---------------------------------------------------
+
+      struct TimeIndexEntry {
+            qreal time;
+            qreal pause;
+            qreal tempo;
+            int tick;
+            };
+      std::vector<TimeIndexEntry> _timeIndex;
+
       void normalize();
       void del(int tick);
 
@@ -200,7 +200,7 @@ bool TextFragment::operator ==(const TextFragment& f) const
 void TextFragment::draw(QPainter* p, const Text* t) const
       {
       QFont f(font(t));
-      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
+      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio());
       p->setFont(f);
       p->drawText(pos, text);
       }
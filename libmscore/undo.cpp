@@ -134,6 +134,20 @@ void UndoCommand::cleanup(bool undo)
             c->cleanup(undo);
       }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    rough estimate of the memory held by the command
+//    and its children
+//---------------------------------------------------------
+
+int UndoCommand::memoryUsage() const
+      {
+      int n = int(sizeof(*this)) + childList.size() * int(sizeof(UndoCommand*));
+      for (auto c : childList)
+            n += c->memoryUsage();
+      return n;
+      }
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -181,9 +195,11 @@ void UndoCommand::unwind()
 
 UndoStack::UndoStack()
       {
-      curCmd   = 0;
-      curIdx   = 0;
-      cleanIdx = 0;
+      curCmd      = 0;
+      curIdx      = 0;
+      cleanIdx    = 0;
+      totalSize   = 0;
+      memoryLimit = qint64(MScore::undoMemoryLimit) * 1024 * 1024;
       }
 
 //---------------------------------------------------------
@@ -227,15 +243,120 @@ void UndoStack::endMacro(bool rollback)
             // remove redo stack
             while (list.size() > curIdx) {
                   UndoCommand* cmd = list.takeLast();
+                  totalSize -= sizeList.takeLast();
                   cmd->cleanup(false);  // delete elements for which UndoCommand() holds ownership
                   delete cmd;
                   }
-            list.append(curCmd);
-            ++curIdx;
+            if (cleanIdx > curIdx)
+                  cleanIdx = -1;
+            if (merge(curCmd))
+                  delete curCmd;
+            else {
+                  int size = curCmd->memoryUsage();
+                  list.append(curCmd);
+                  sizeList.append(size);
+                  totalSize += size;
+                  ++curIdx;
+                  trim();
+                  }
             }
       curCmd = 0;
       }
 
+//---------------------------------------------------------
+//   propertyChanges
+//    collect the ChangeProperty commands of a macro;
+//    return false if it contains other commands than
+//    SaveState and ChangeProperty
+//---------------------------------------------------------
+
+static bool propertyChanges(const UndoCommand* macro, QList<const ChangeProperty*>* l)
+      {
+      for (const UndoCommand* c : macro->commands()) {
+            if (!strcmp(c->name(), "ChangeProperty"))
+                  l->append(static_cast<const ChangeProperty*>(c));
+            else if (strcmp(c->name(), "SaveState"))
+                  return false;
+            }
+      return !l->empty();
+      }
+
+//---------------------------------------------------------
+//   setMergeable
+//    allow the current macro to be merged with the
+//    previous one, see merge()
+//---------------------------------------------------------
+
+void UndoStack::setMergeable(bool val)
+      {
+      if (curCmd == 0) {
+            qWarning("UndoStack:setMergeable(): not active");
+            return;
+            }
+      curCmd->setMergeable(val);
+      }
+
+//---------------------------------------------------------
+//   merge
+//    Coalesce a mergeable macro which only changes the
+//    same properties of the same elements as the previous
+//    mergeable macro, like repeated drags of one element,
+//    into the previous macro. Undoing that macro already
+//    restores the values from before the whole run, so
+//    the new macro can be dropped.
+//    Return true if cmd was merged and can be deleted.
+//---------------------------------------------------------
+
+bool UndoStack::merge(UndoCommand* cmd)
+      {
+      if (curIdx == 0 || cleanIdx == curIdx)
+            return false;
+      if (!cmd->mergeable() || !list[curIdx - 1]->mergeable())
+            return false;
+      QList<const ChangeProperty*> l1;
+      QList<const ChangeProperty*> l2;
+      if (!propertyChanges(list[curIdx - 1], &l1) || !propertyChanges(cmd, &l2))
+            return false;
+      if (l1.size() != l2.size())
+            return false;
+      for (int i = 0; i < l1.size(); ++i) {
+            if (l1[i]->getElement() != l2[i]->getElement() || l1[i]->getId() != l2[i]->getId())
+                  return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   trim
+//    drop the oldest commands while the history is over
+//    its memory budget; the last command is always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+      {
+      if (memoryLimit <= 0)
+            return;
+      while (totalSize > memoryLimit && curIdx > 1) {
+            UndoCommand* cmd = list.takeFirst();
+            totalSize -= sizeList.takeFirst();
+            cmd->cleanup(true);
+            delete cmd;
+            --curIdx;
+            if (cleanIdx >= 0)
+                  --cleanIdx;
+            }
+      }
+
+//---------------------------------------------------------
+//   setLimit
+//---------------------------------------------------------
+
+void UndoStack::setLimit(qint64 bytes)
+      {
+      memoryLimit = bytes;
+      trim();
+      }
+
 //---------------------------------------------------------
 //   push
 //---------------------------------------------------------
@@ -350,6 +471,12 @@ void SaveState::redo()
       score->setSelection(redoSelection);
       }
 
+int SaveState::memoryUsage() const
+      {
+      int n = undoSelection.elements().size() + redoSelection.elements().size();
+      return int(sizeof(*this)) + n * int(sizeof(Element*));
+      }
+
 //---------------------------------------------------------
 //   undoChangeProperty
 //---------------------------------------------------------
@@ -1853,6 +1980,25 @@ void RemoveElement::cleanup(bool undo)
             }
       }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    the removed element and its children are owned by
+//    the command
+//---------------------------------------------------------
+
+static void countElement(void* data, Element*)
+      {
+      ++*static_cast<int*>(data);
+      }
+
+int RemoveElement::memoryUsage() const
+      {
+      int n = 0;
+      if (element)
+            element->scanElements(&n, countElement, true);
+      return int(sizeof(*this)) + n * int(sizeof(Element));
+      }
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -3361,6 +3507,26 @@ void ChangeStaffUserDist::flip()
       staff->score()->setLayoutAll();
       }
 
+//---------------------------------------------------------
+//   addRenderRefresh
+//    repaint an element changed by a render only property;
+//    spanner properties are shared by all segments
+//---------------------------------------------------------
+
+static void addRenderRefresh(Score* score, Element* e)
+      {
+      Spanner* sp = nullptr;
+      if (e->isSpanner())
+            sp = static_cast<Spanner*>(e);
+      else if (e->isSpannerSegment())
+            sp = static_cast<SpannerSegment*>(e)->spanner();
+      if (sp) {
+            for (SpannerSegment* ss : sp->spannerSegments())
+                  score->addRefresh(ss->canvasBoundingRect());
+            }
+      score->addRefresh(e->canvasBoundingRect());
+      }
+
 //---------------------------------------------------------
 //   ChangeProperty::flip
 //---------------------------------------------------------
@@ -3374,11 +3540,31 @@ void ChangeProperty::flip()
 
       QVariant v       = element->getProperty(id);
       PropertyStyle ps = element->propertyStyle(id);
+
+      // setProperty() requests a layout for most properties;
+      // drop it if the property does not change the geometry
+      Element* e   = dynamic_cast<Element*>(element);
+      PropertyInvalidation inv = e ? propertyInvalidation(id) : PropertyInvalidation::LAYOUT;
+      Score* score = element->score();
+      CmdState cs  = score->cmdState();
+
       if (propertyStyle == PropertyStyle::STYLED)
             element->resetProperty(id);
       else
             element->setProperty(id, property);
 
+      if (inv != PropertyInvalidation::LAYOUT) {
+            score->cmdState().restoreLayout(cs);
+            if (inv == PropertyInvalidation::PLAYBACK) {
+                  score->cmdState().setPlayTick(e->tick());
+                  score->masterScore()->setPlaylistDirty();
+                  }
+            else {
+                  score->cmdState()._renderChanged = true;
+                  addRenderRefresh(score, e);
+                  }
+            }
+
       if (id == P_ID::SPANNER_TICK || id == P_ID::SPANNER_TICKS) {
             static_cast<Element*>(element)->score()->addSpanner(static_cast<Spanner*>(element));
             // while updating ticks for an Ottava, the parent staff calls updateOttava()
@@ -94,6 +94,7 @@ enum class LayoutMode : char;
 
 class UndoCommand {
       QList<UndoCommand*> childList;
+      bool _mergeable { false };          // see UndoStack::merge()
 
    protected:
       virtual void flip() {}
@@ -105,8 +106,12 @@ class UndoCommand {
       void appendChild(UndoCommand* cmd) { childList.append(cmd);       }
       UndoCommand* removeChild()         { return childList.takeLast(); }
       int childCount() const             { return childList.size();     }
+      const QList<UndoCommand*>& commands() const { return childList; }
+      bool mergeable() const             { return _mergeable;           }
+      void setMergeable(bool val)        { _mergeable = val;            }
       void unwind();
       virtual void cleanup(bool undo);
+      virtual int memoryUsage() const;
 // #ifndef QT_NO_DEBUG
       virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -119,8 +124,14 @@ class UndoCommand {
 class UndoStack {
       UndoCommand* curCmd;
       QList<UndoCommand*> list;
+      QList<int> sizeList;          // estimated memory usage of the commands in list
+      qint64 totalSize;
+      qint64 memoryLimit;           // 0: unlimited
       int curIdx;
-      int cleanIdx;
+      int cleanIdx;                 // -1: clean state is no longer reachable
+
+      bool merge(UndoCommand*);
+      void trim();
 
    public:
       UndoStack();
@@ -132,6 +143,7 @@ class UndoStack {
       void push(UndoCommand*);      // push & execute
       void push1(UndoCommand*);
       void pop();
+      void setMergeable(bool val = true);
       void setClean();
       bool canUndo() const          { return curIdx > 0;           }
       bool canRedo() const          { return curIdx < list.size(); }
@@ -140,6 +152,11 @@ class UndoStack {
       UndoCommand* current() const  { return curCmd;               }
       void undo();
       void redo();
+
+      int count() const             { return list.size();          }
+      qint64 memoryUsage() const    { return totalSize;            }
+      qint64 limit() const          { return memoryLimit;          }
+      void setLimit(qint64 bytes);
       };
 
 //---------------------------------------------------------
@@ -157,6 +174,7 @@ class SaveState : public UndoCommand {
       SaveState(Score*);
       virtual void undo();
       virtual void redo();
+      virtual int memoryUsage() const override;
       UNDO_NAME("SaveState")
       };
 
@@ -563,6 +581,7 @@ class RemoveElement : public UndoCommand {
       virtual void undo();
       virtual void redo();
       virtual void cleanup(bool);
+      virtual int memoryUsage() const override;
       virtual const char* name() const override;
       };
 
@@ -1038,6 +1057,8 @@ class ChangeProperty : public UndoCommand {
       ChangeProperty(ScoreElement* e, P_ID i, const QVariant& v, PropertyStyle ps = PropertyStyle::NOSTYLE)
          : element(e), id(i), property(v), propertyStyle(ps) {}
       P_ID getId() const  { return id; }
+      ScoreElement* getElement() const { return element; }
+      virtual int memoryUsage() const override { return int(sizeof(*this)); }
       UNDO_NAME("ChangeProperty")
       };
 
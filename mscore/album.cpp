@@ -78,6 +78,11 @@ void Album::print()
       double mag = printer.logicalDpiX() / DPI;
       painter.scale(mag, mag);
 
+      RenderContext ctx = MScore::renderContext();
+      ctx.dpi      = printer.logicalDpiX();
+      ctx.printing = true;
+      RenderScope scope(ctx);
+
       int fromPage = printer.fromPage() - 1;
       int toPage   = printer.toPage()   - 1;
       if (fromPage < 0)
@@ -97,7 +102,6 @@ void Album::print()
             Score* score = item->score;
             if (score == 0)
                   continue;
-            score->setPrinting(true);
             //
             // here we ignore the configured page offset
             //
@@ -115,7 +119,6 @@ void Album::print()
                   QList<Element*> ell = page->items(fr);
                   qStableSort(ell.begin(), ell.end(), elementLessThan);
                   for (const Element* e : ell) {
-                        e->itemDiscovered = 0;
                         if (!e->visible())
                               continue;
                         QPointF pos(e->pagePos());
@@ -127,7 +130,6 @@ void Album::print()
             pageOffset += pages;
             if(item != _scores.last())
                   printer.newPage();
-            score->setPrinting(false);
             score->setPageNumberOffset(oldPageOffset);
             }
       painter.end();
@@ -154,6 +154,8 @@ void ScoreView::endDrag()
                         e->score()->undoPropertyChanged(e, P_ID::USER_OFF, e->startDragPosition());
                         }
                   }
+            // repeated drags of the same elements are one undo step
+            _score->undoStack()->setMergeable();
             }
       _score->setLayoutAll();
       dragElement = 0;
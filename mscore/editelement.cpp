@@ -117,6 +117,10 @@ void ScoreView::endEdit()
             if (text->empty() && text->parent() && text->parent()->type() != Element::Type::TBOX)
                   _score->undoRemoveElement(text);
             }
+      else {
+            // repeated edit drags of the same element are one undo step
+            _score->undoStack()->setMergeable();
+            }
 
       _score->endCmd();
 
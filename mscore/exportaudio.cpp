@@ -38,6 +38,46 @@ namespace Ms {
 
 bool MuseScore::saveAudio(Score* score, const QString& name)
       {
+      return renderAudio(score, QStringList(name), false);
+      }
+
+//---------------------------------------------------------
+//   saveAudioParts
+//    write one file per part; "__part__<n>" is appended
+//    to the base name, before the extension if there is
+//    one. Every MIDI channel is rendered to
+//    the bus of its part, so the score is synthesized only
+//    once. The parts are dry: the master effects are not
+//    applied.
+//---------------------------------------------------------
+
+bool MuseScore::saveAudioParts(Score* score, const QString& name)
+      {
+      int n       = score->parts().size();
+      int padding = QString("%1").arg(n).size();
+      int dot     = name.lastIndexOf('.');
+      if (dot < 0 || dot < name.lastIndexOf('/'))
+            dot = name.size();          // no extension
+      QStringList names;
+      for (int idx = 0; idx < n; ++idx) {
+            QString suffix = QString("__part__%1").arg(idx, padding, 10, QLatin1Char('0'));
+            names.append(name.left(dot) + suffix + name.mid(dot));
+            }
+      return renderAudio(score, names, true);
+      }
+
+//---------------------------------------------------------
+//   renderAudio
+//    render the score to the files in names: the mix to
+//    names[0], or with parts set every part to its own
+//    file. All files are normalized with the same gain.
+//---------------------------------------------------------
+
+bool MuseScore::renderAudio(Score* score, const QStringList& names, bool parts)
+      {
+      if (names.isEmpty())
+            return false;
+      const QString& name = names[0];
       int format;
       if (name.endsWith(".wav"))
             format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
@@ -71,12 +111,20 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
       info.channels   = 2;
       info.samplerate = sampleRate;
       info.format     = format;
-      SNDFILE* sf     = sf_open(qPrintable(name), SFM_WRITE, &info);
-      if (sf == 0) {
-            qDebug("open soundfile failed: %s", sf_strerror(sf));
-            delete synti;
-            MScore::sampleRate = oldSampleRate;
-            return false;
+      QList<SNDFILE*> files;
+      for (const QString& fn : names) {
+            SNDFILE* sf = sf_open(qPrintable(fn), SFM_WRITE, &info);
+            if (sf == 0) {
+                  qDebug("open soundfile <%s> failed: %s", qPrintable(fn), sf_strerror(sf));
+                  for (int i = 0; i < files.size(); ++i) {
+                        sf_close(files[i]);
+                        QFile::remove(names[i]);
+                        }
+                  delete synti;
+                  MScore::sampleRate = oldSampleRate;
+                  return false;
+                  }
+            files.append(sf);
             }
 
       QProgressDialog progress(this);
@@ -89,7 +137,6 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
             progress.show();
 
       float peak  = 0.0;
-      double gain = 1.0;
       EventMap::const_iterator endPos = events.cend();
       --endPos;
       const int et = (score->utick2utime(endPos->first) + 1) * MScore::sampleRate;
@@ -97,119 +144,186 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
 
       progress.setRange(0, et);
 
-      for (int pass = 0; pass < 2; ++pass) {
-            EventMap::const_iterator playPos;
-            playPos = events.cbegin();
-            synti->allSoundsOff(-1);
+      //
+      // The score is synthesized only once. The unnormalized
+      // output is spilled to a temporary float file while the peak is
+      // tracked; the second stage only scales and encodes.
+      //
+      QTemporaryFile spill;
+      if (!spill.open()) {
+            qDebug("saveAudio: cannot create temporary file");
+            for (int i = 0; i < files.size(); ++i) {
+                  sf_close(files[i]);
+                  QFile::remove(names[i]);
+                  }
+            delete synti;
+            MScore::sampleRate = oldSampleRate;
+            return false;
+            }
 
-            //
-            // init instruments
-            //
-            foreach(Part* part, score->parts()) {
-                  const InstrumentList* il = part->instruments();
-                  for(auto i = il->begin(); i!= il->end(); i++) {
-                        foreach(const Channel* a, i->second->channel()) {
-                              a->updateInitList();
-                              foreach(MidiCoreEvent e, a->init) {
-                                    if (e.type() == ME_INVALID)
-                                          continue;
-                                    e.setChannel(a->channel);
-                                    int syntiIdx = synti->index(score->masterScore()->midiMapping(a->channel)->articulation->synti);
-                                    synti->play(e, syntiIdx);
-                                    }
+      QElapsedTimer timer;
+      timer.start();
+
+      EventMap::const_iterator playPos = events.cbegin();
+      synti->allSoundsOff(-1);
+
+      //
+      // init instruments; with parts set every channel is
+      // routed to the bus of its part
+      //
+      const int channels = score->masterScore()->midiMapping()->size();
+      std::vector<int> channelBus(channels, 0);
+      int partIdx = 0;
+      foreach(Part* part, score->parts()) {
+            const InstrumentList* il = part->instruments();
+            for(auto i = il->begin(); i!= il->end(); i++) {
+                  foreach(const Channel* a, i->second->channel()) {
+                        if (parts && a->channel < channels)
+                              channelBus[a->channel] = partIdx;
+                        a->updateInitList();
+                        foreach(MidiCoreEvent e, a->init) {
+                              if (e.type() == ME_INVALID)
+                                    continue;
+                              e.setChannel(a->channel);
+                              int syntiIdx = synti->index(score->masterScore()->midiMapping(a->channel)->articulation->synti);
+                              synti->play(e, syntiIdx);
                               }
                         }
                   }
+            ++partIdx;
+            }
 
-            static const unsigned FRAMES = 512;
-            float buffer[FRAMES * 2];
-            int playTime = 0;
-
-            for (;;) {
-                  unsigned frames = FRAMES;
-                  //
-                  // collect events for one segment
-                  //
-                  float max = 0.0;
-                  memset(buffer, 0, sizeof(float) * FRAMES * 2);
-                  int endTime = playTime + frames;
-                  float* p = buffer;
-                  for (; playPos != events.cend(); ++playPos) {
-                        int f = score->utick2utime(playPos->first) * MScore::sampleRate;
-                        if (f >= endTime)
-                              break;
-                        int n = f - playTime;
-                        if (n) {
-                              synti->process(n, p);
-                              p += 2 * n;
-                              }
+      static const unsigned FRAMES = 512;
+      const int buses = files.size();
+      std::vector<float> buffer(buses * FRAMES * 2);
+      std::vector<float*> bus(channels);
+      int playTime = 0;
+      bool writeError = false;
 
-                        playTime  += n;
-                        frames    -= n;
-                        const NPlayEvent& e = playPos->second;
-                        if (e.isChannelEvent()) {
-                              int channelIdx = e.channel();
-                              Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
-                              if (!c->mute) {
-                                    synti->play(e, synti->index(c->synti));
-                                    }
-                              }
-                        }
-                  if (frames) {
-                        synti->process(frames, p);
-                        playTime += frames;
-                        }
-                  if (pass == 1) {
-                        for (unsigned i = 0; i < FRAMES * 2; ++i) {
-                              max = qMax(max, qAbs(buffer[i]));
-                              buffer[i] *= gain;
-                              }
-                        sf_writef_float(sf, buffer, FRAMES);
-                        }
-                  else {
-                        for (unsigned i = 0; i < FRAMES * 2; ++i) {
-                              max = qMax(max, qAbs(buffer[i]));
-                              peak = qMax(peak, qAbs(buffer[i]));
+      // render n frames at offset of the current segment
+      auto process = [&](unsigned n, unsigned offset) -> bool {
+            if (!parts) {
+                  synti->process(n, buffer.data() + offset * 2);
+                  return true;
+                  }
+            for (int c = 0; c < channels; ++c)
+                  bus[c] = buffer.data() + (channelBus[c] * FRAMES + offset) * 2;
+            return synti->processChannels(n, bus.data(), channels);
+            };
+
+      for (;;) {
+            unsigned frames = FRAMES;
+            //
+            // collect events for one segment
+            //
+            float max = 0.0;
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+            int endTime = playTime + frames;
+            for (; playPos != events.cend(); ++playPos) {
+                  int f = score->utick2utime(playPos->first) * MScore::sampleRate;
+                  if (f >= endTime)
+                        break;
+                  int n = f - playTime;
+                  if (n && !process(n, FRAMES - frames))
+                        writeError = true;
+
+                  playTime  += n;
+                  frames    -= n;
+                  const NPlayEvent& e = playPos->second;
+                  if (e.isChannelEvent()) {
+                        int channelIdx = e.channel();
+                        Channel* c = score->masterScore()->midiMapping(channelIdx)->articulation;
+                        if (!c->mute) {
+                              synti->play(e, synti->index(c->synti));
                               }
                         }
-                  playTime = endTime;
-                  if (!MScore::noGui) {
-                        if (progress.wasCanceled())
-                              break;
-                        progress.setValue((pass * et + playTime) / 2);
-                        qApp->processEvents();
-                        }
-                  if (playTime >= et)
-                        synti->allNotesOff(-1);
-                  // create sound until the sound decays
-                  if (playTime >= et && max*peak < 0.000001)
-                        break;
-                  // hard limit
-                  if (playTime > maxEndTime)
+                  }
+            if (frames) {
+                  if (!process(frames, FRAMES - frames))
+                        writeError = true;
+                  playTime += frames;
+                  }
+            if (writeError)
+                  break;
+            for (float v : buffer) {
+                  max = qMax(max, qAbs(v));
+                  peak = qMax(peak, qAbs(v));
+                  }
+            qint64 bytes = buffer.size() * sizeof(float);
+            if (spill.write(reinterpret_cast<const char*>(buffer.data()), bytes) != bytes) {
+                  qDebug("saveAudio: write to temporary file failed");
+                  writeError = true;
+                  break;
+                  }
+            playTime = endTime;
+            if (!MScore::noGui) {
+                  if (progress.wasCanceled())
                         break;
+                  progress.setValue(playTime / 2);
+                  qApp->processEvents();
                   }
-            if (progress.wasCanceled())
+            if (playTime >= et)
+                  synti->allNotesOff(-1);
+            // create sound until the sound decays
+            if (playTime >= et && max*peak < 0.000001)
                   break;
-            if (pass == 0 && peak == 0.0) {
-                  qDebug("song is empty");
+            // hard limit
+            if (playTime > maxEndTime)
                   break;
+            }
+      qint64 renderTime = timer.restart();
+
+      //
+      // normalize and encode
+      //
+      if (!writeError && !progress.wasCanceled()) {
+            if (peak == 0.0)
+                  qDebug("song is empty");
+            else {
+                  const double gain = 0.99 / peak;
+                  const qint64 totalBytes = spill.size();
+                  const qint64 bytes = buffer.size() * sizeof(float);
+                  spill.seek(0);
+                  for (;;) {
+                        if (spill.read(reinterpret_cast<char*>(buffer.data()), bytes) != bytes)
+                              break;
+                        for (float& v : buffer)
+                              v *= gain;
+                        for (int i = 0; i < buses; ++i)
+                              sf_writef_float(files[i], buffer.data() + i * FRAMES * 2, FRAMES);
+                        if (!MScore::noGui) {
+                              if (progress.wasCanceled())
+                                    break;
+                              progress.setValue((et + et * spill.pos() / totalBytes) / 2);
+                              qApp->processEvents();
+                              }
+                        }
                   }
-            gain = 0.99 / peak;
             }
+      qint64 writeTime = timer.elapsed();
+      qDebug("saveAudio: <%s> %d file(s), render %lld ms, normalize/encode %lld ms",
+         qPrintable(name), buses, renderTime, writeTime);
 
       bool wasCanceled = progress.wasCanceled();
       progress.close();
 
       MScore::sampleRate = oldSampleRate;
       delete synti;
-      if (sf_close(sf)) {
-            qDebug("close soundfile failed");
+      bool closeError = false;
+      for (SNDFILE* sf : files) {
+            if (sf_close(sf)) {
+                  qDebug("close soundfile failed");
+                  closeError = true;
+                  }
+            }
+      if (closeError)
             return false;
+      if (wasCanceled || writeError) {
+            for (const QString& fn : names)
+                  QFile::remove(fn);
             }
-      if (wasCanceled)
-            QFile::remove(name);
 
-      return true;
+      return !writeError;
       }
 
 #endif // HAS_AUDIOFILE
@@ -1509,8 +1509,10 @@ void MuseScore::printFile()
             p.setRenderHint(QPainter::TextAntialiasing, true);
             double mag = printerDev.logicalDpiX() / DPI;
 
-            double pr = MScore::pixelRatio;
-            MScore::pixelRatio = 1.0 / mag;
+            RenderContext ctx;
+            ctx.pixelRatio = 1.0 / mag;
+            ctx.dpi        = printerDev.logicalDpiX();
+            RenderScope scope(ctx);
             p.scale(mag, mag);
 
             int fromPage = printerDev.fromPage() - 1;
@@ -1533,7 +1535,6 @@ void MuseScore::printFile()
                         }
                   }
             p.end();
-            MScore::pixelRatio = pr;
             }
 
       if (layoutMode != cs->layoutMode()) {
@@ -1885,9 +1886,6 @@ bool MuseScore::savePdf(const QString& saveName)
 
 bool MuseScore::savePdf(Score* cs, const QString& saveName)
       {
-      cs->setPrinting(true);
-      MScore::pdfPrinting = true;
-
       QPdfWriter printerDev(saveName);
       printerDev.setResolution(preferences.exportPdfDpi);
       const PageFormat* pf = cs->pageFormat();
@@ -1908,8 +1906,12 @@ bool MuseScore::savePdf(Score* cs, const QString& saveName)
          pf->size().height()*printerDev.logicalDpiY()));
       p.setWindow(QRect(0.0, 0.0, pf->size().width() * DPI, pf->size().height() * DPI));
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = DPI / printerDev.logicalDpiX();
+      RenderContext ctx;
+      ctx.pixelRatio = DPI / printerDev.logicalDpiX();
+      ctx.dpi        = printerDev.logicalDpiX();
+      ctx.printing   = true;
+      ctx.pdf        = true;
+      RenderScope scope(ctx);
 
       const QList<Page*> pl = cs->pages();
       int pages = pl.size();
@@ -1921,10 +1923,6 @@ bool MuseScore::savePdf(Score* cs, const QString& saveName)
             cs->print(&p, n);
             }
       p.end();
-      cs->setPrinting(false);
-
-      MScore::pixelRatio = pr;
-      MScore::pdfPrinting = false;
       return true;
       }
 
@@ -1959,20 +1957,27 @@ bool MuseScore::savePdf(QList<Score*> cs, const QString& saveName)
          pf->size().height()*printerDev.logicalDpiY()));
       p.setWindow(QRect(0.0, 0.0, pf->size().width() * DPI, pf->size().height() * DPI));
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = DPI / printerDev.logicalDpiX();
-      MScore::pdfPrinting = true;
+      // lay out all scores first, part scores may be laid out
+      // concurrently; the layout runs in the render context of
+      // the caller, like the layout of the other threads
+      QList<LayoutMode> layoutModes;
+      for (Score* s : cs) {
+            layoutModes.append(s->layoutMode());
+            s->setLayoutMode(LayoutMode::PAGE);
+            }
+      Score::layoutScores(cs);
 
+      {
+      RenderContext ctx;
+      ctx.pixelRatio = DPI / printerDev.logicalDpiX();
+      ctx.dpi        = printerDev.logicalDpiX();
+      ctx.printing   = true;
+      ctx.pdf        = true;
+      RenderScope scope(ctx);
+
+      // pages are printed in order
       bool firstPage = true;
       for (Score* s : cs) {
-            LayoutMode layoutMode = s->layoutMode();
-            if (layoutMode != LayoutMode::PAGE) {
-                  s->setLayoutMode(LayoutMode::PAGE);
-            //      s->doLayout();
-                  }
-            s->doLayout();
-            s->setPrinting(true);
-
             const PageFormat* pf = s->pageFormat();
             printerDev.setPaperSize(pf->size(), QPrinter::Inch);
 
@@ -1984,17 +1989,18 @@ bool MuseScore::savePdf(QList<Score*> cs, const QString& saveName)
                   firstPage = false;
                   s->print(&p, n);
                   }
-            //reset score
-            s->setPrinting(false);
+            }
+      p.end();
+      }
 
-            if (layoutMode != s->layoutMode()) {
-                  s->setLayoutMode(layoutMode);
+      //reset scores
+      for (int i = 0; i < cs.size(); ++i) {
+            Score* s = cs[i];
+            if (layoutModes[i] != s->layoutMode()) {
+                  s->setLayoutMode(layoutModes[i]);
                   s->doLayout();
                   }
             }
-      p.end();
-      MScore::pdfPrinting = false;
-      MScore::pixelRatio = pr;
       return true;
       }
 
@@ -2331,76 +2337,111 @@ bool MuseScore::savePng(Score* score, const QString& name)
       }
 
 //---------------------------------------------------------
-//   savePng with options
-//    return true on success
+//   PngPage
+//    one page of a png export
 //---------------------------------------------------------
 
-bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool transparent, double convDpi, int trimMargin, QImage::Format format)
+struct PngPage {
+      Page* page;
+      QString fileName;
+      const RenderContext* ctx;
+      bool transparent;
+      int trimMargin;
+      QImage::Format format;
+      bool ok;
+      };
+
+//---------------------------------------------------------
+//   savePngPage
+//    rasterize and write one page; all render state is
+//    taken from the page's RenderContext, so pages can be
+//    saved concurrently
+//---------------------------------------------------------
+
+static void savePngPage(PngPage& pp)
       {
-      bool rv = true;
-      score->setPrinting(!screenshot);    // dont print page break symbols etc.
-      double pr = MScore::pixelRatio;
+      RenderScope scope(*pp.ctx);
 
       QImage::Format f;
-      if (format != QImage::Format_Indexed8)
-          f = format;
+      if (pp.format != QImage::Format_Indexed8)
+          f = pp.format;
       else
           f = QImage::Format_ARGB32_Premultiplied;
 
-      const QList<Page*>& pl = score->pages();
-      int pages = pl.size();
+      Page* page     = pp.page;
+      double convDpi = pp.ctx->dpi;
 
-      int padding = QString("%1").arg(pages).size();
-      bool overwrite = false;
-      bool noToAll = false;
-      for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
-            Page* page = pl.at(pageNumber);
+      QRectF r;
+      if (pp.trimMargin >= 0) {
+            QMarginsF margins(pp.trimMargin, pp.trimMargin, pp.trimMargin, pp.trimMargin);
+            r = page->tbbox() + margins;
+            }
+      else
+            r = page->abbox();
+      int w = lrint(r.width()  * convDpi / DPI);
+      int h = lrint(r.height() * convDpi / DPI);
 
-            QRectF r;
-            if (trimMargin >= 0) {
-                  QMarginsF margins(trimMargin, trimMargin, trimMargin, trimMargin);
-                  r = page->tbbox() + margins;
-                  }
-            else
-                  r = page->abbox();
-            int w = lrint(r.width()  * convDpi / DPI);
-            int h = lrint(r.height() * convDpi / DPI);
+      QImage printer(w, h, f);
+      printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
+      printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
 
-            QImage printer(w, h, f);
-            printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
-            printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
+      printer.fill(pp.transparent ? 0 : 0xffffffff);
 
-            printer.fill(transparent ? 0 : 0xffffffff);
+      double mag = convDpi / DPI;
 
-            double mag = convDpi / DPI;
-            MScore::pixelRatio = 1.0 / mag;
+      QPainter p(&printer);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag, mag);
+      if (pp.trimMargin >= 0)
+            p.translate(-r.topLeft());
 
-            QPainter p(&printer);
-            p.setRenderHint(QPainter::Antialiasing, true);
-            p.setRenderHint(QPainter::TextAntialiasing, true);
-            p.scale(mag, mag);
-            if (trimMargin >= 0)
-                  p.translate(-r.topLeft());
+      QList<Element*> pel = page->elements();
+      qStableSort(pel.begin(), pel.end(), elementLessThan);
+      paintElements(p, pel);
+      p.end();
 
-            QList<Element*> pel = page->elements();
-            qStableSort(pel.begin(), pel.end(), elementLessThan);
-            paintElements(p, pel);
-
-            if (format == QImage::Format_Indexed8) {
-                  //convert to grayscale & respect alpha
-                  QVector<QRgb> colorTable;
-                  colorTable.push_back(QColor(0, 0, 0, 0).rgba());
-                  if (!transparent) {
-                        for (int i = 1; i < 256; i++)
-                              colorTable.push_back(QColor(i, i, i).rgb());
-                        }
-                  else {
-                        for (int i = 1; i < 256; i++)
-                              colorTable.push_back(QColor(0, 0, 0, i).rgba());
-                        }
-                  printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
+      if (pp.format == QImage::Format_Indexed8) {
+            //convert to grayscale & respect alpha
+            QVector<QRgb> colorTable;
+            colorTable.push_back(QColor(0, 0, 0, 0).rgba());
+            if (!pp.transparent) {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(i, i, i).rgb());
+                  }
+            else {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(0, 0, 0, i).rgba());
                   }
+            printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
+            }
+      pp.ok = printer.save(pp.fileName, "png");
+      }
 
+//---------------------------------------------------------
+//   savePng with options
+//    return true on success
+//---------------------------------------------------------
+
+bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool transparent, double convDpi, int trimMargin, QImage::Format format)
+      {
+      RenderContext ctx;
+      ctx.pixelRatio = DPI / convDpi;
+      ctx.dpi        = convDpi;
+      ctx.printing   = !screenshot;     // dont print page break symbols etc.
+
+      const QList<Page*>& pl = score->pages();
+      int pages = pl.size();
+
+      //
+      // decide on all file names first, the pages are
+      // then rendered and saved on the thread pool
+      //
+      QVector<PngPage> pngPages;
+      int padding = QString("%1").arg(pages).size();
+      bool overwrite = false;
+      bool noToAll = false;
+      for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
             QString fileName(name);
             if (fileName.endsWith(".png"))
                   fileName = fileName.left(fileName.size() - 4);
@@ -2429,13 +2470,23 @@ bool MuseScore::savePng(Score* score, const QString& name, bool screenshot, bool
                               continue;
                         }
                   }
-            rv = printer.save(fileName, "png");
-            if (!rv)
-                  break;
+            pngPages.append({ pl.at(pageNumber), fileName, &ctx, transparent, trimMargin, format, false });
             }
-      score->setPrinting(false);
-      MScore::pixelRatio = pr;
-      return rv;
+
+      if (pngPages.size() > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1)
+            QtConcurrent::blockingMap(pngPages, savePngPage);
+      else {
+            for (PngPage& pp : pngPages) {
+                  savePngPage(pp);
+                  if (!pp.ok)
+                        return false;
+                  }
+            }
+      for (const PngPage& pp : pngPages) {
+            if (!pp.ok)
+                  return false;
+            }
+      return true;
       }
 
 //---------------------------------------------------------
@@ -2567,8 +2618,12 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
       printer.setSize(QSize(w, h));
       printer.setViewBox(QRectF(0, 0, w, h));
 
-      score->setPrinting(true);
-      MScore::pdfPrinting = true;
+      RenderContext ctx;
+      ctx.pixelRatio = DPI / printer.logicalDpiX();
+      ctx.dpi        = printer.logicalDpiX();
+      ctx.printing   = true;
+      ctx.pdf        = true;
+      RenderScope scope(ctx);
 
       QPainter p(&printer);
       p.setRenderHint(QPainter::Antialiasing, true);
@@ -2577,9 +2632,6 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
       if (trimMargin >= 0 && score->npages() == 1)
             p.translate(-r.topLeft());
 
-      double pr = MScore::pixelRatio;
-      MScore::pixelRatio = DPI / printer.logicalDpiX();
-
       for (Page* page : score->pages()) {
             // 1st pass: StaffLines
             for  (System* s : page->systems()) {
@@ -2657,9 +2709,6 @@ bool MuseScore::saveSvg(Score* score, const QString& saveName)
             }
 
       // Clean up and return
-      MScore::pixelRatio = pr;
-      score->setPrinting(false);
-      MScore::pdfPrinting = false;
       p.end(); // Writes MuseScore SVG file to disk, finally
       return true;
       }
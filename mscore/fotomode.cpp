@@ -779,7 +779,7 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
       int w = lrint(r.width()  * mag);
       int h = lrint(r.height() * mag);
 
-      double pr = MScore::pixelRatio;
+      RenderContext ctx;
       if (ext == "pdf") {
             QPrinter printer(QPrinter::HighResolution);
             mag = printer.logicalDpiX() / DPI;
@@ -791,7 +791,9 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             printer.setOutputFileName(fn);
             if (ext == "pdf")
                   printer.setOutputFormat(QPrinter::PdfFormat);
-            MScore::pixelRatio = DPI / printer.logicalDpiX();
+            ctx.pixelRatio = DPI / printer.logicalDpiX();
+            ctx.dpi        = printer.logicalDpiX();
+            RenderScope scope(ctx);
             QPainter p(&printer);
             paintRect(printMode, p, r, mag);
             }
@@ -803,11 +805,12 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             printer.setTitle(_score->title());
             printer.setSize(QSize(w, h));
             printer.setViewBox(QRect(0, 0, w, h));
-            MScore::pixelRatio = DPI / printer.logicalDpiX();
+            ctx.pixelRatio = DPI / printer.logicalDpiX();
+            ctx.dpi        = printer.logicalDpiX();
+            ctx.pdf        = true;
+            RenderScope scope(ctx);
             QPainter p(&printer);
-            MScore::pdfPrinting = true;
             paintRect(printMode, p, r, mag);
-            MScore::pdfPrinting = false;
             }
       else if (ext == "png") {
             QImage::Format f = QImage::Format_ARGB32_Premultiplied;
@@ -815,14 +818,15 @@ bool ScoreView::saveFotoAs(bool printMode, const QRectF& r)
             printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
             printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
             printer.fill(transparent ? 0 : 0xffffffff);
-            MScore::pixelRatio = 1.0 / mag;
+            ctx.pixelRatio = 1.0 / mag;
+            ctx.dpi        = convDpi;
+            RenderScope scope(ctx);
             QPainter p(&printer);
             paintRect(printMode, p, r, mag);
             printer.save(fn, "png");
             }
       else
             qDebug("unknown extension <%s>", qPrintable(ext));
-      MScore::pixelRatio = pr;
       return true;
       }
 
@@ -837,8 +841,11 @@ void ScoreView::paintRect(bool printMode, QPainter& p, const QRectF& r, double m
       p.setRenderHint(QPainter::Antialiasing, true);
       p.setRenderHint(QPainter::TextAntialiasing, true);
 
-      score()->setPrinting(printMode);
+      RenderContext ctx = MScore::renderContext();
+      ctx.printing = printMode;
+      RenderScope scope(ctx);
 
+      std::vector<Element*> el;     // reused for every page
       foreach (Page* page, _score->pages()) {
             // QRectF pr(page->abbox());
             QRectF pr(page->canvasBoundingRect());
@@ -847,13 +854,12 @@ void ScoreView::paintRect(bool printMode, QPainter& p, const QRectF& r, double m
             if (pr.left() > r.right())
                   break;
             p.translate(page->pos());
-            QList<Element*> ell = page->items(r.translated(-page->pos()));
-            qStableSort(ell.begin(), ell.end(), elementLessThan);
-            drawElements(p, ell);
+            el.clear();
+            page->items(r.translated(-page->pos()), &el);
+            qStableSort(el.begin(), el.end(), elementLessThan);
+            drawElements(p, el);
             p.translate(-page->pos());
             }
-
-      score()->setPrinting(false);
       p.end();
       }
 
@@ -882,10 +888,11 @@ void ScoreView::fotoDragDrop(QMouseEvent*)
       printer.setTitle(_score->title());
       printer.setSize(QSize(w, h));
       printer.setViewBox(QRect(0, 0, w, h));
+      RenderContext ctx = MScore::renderContext();
+      ctx.pdf = true;
+      RenderScope scope(ctx);
       QPainter p(&printer);
-      MScore::pdfPrinting = true;
       paintRect(printMode, p, r, 1);
-      MScore::pdfPrinting = false;
 
       QDrag* drag = new QDrag(this);
       QMimeData* mimeData = new QMimeData;
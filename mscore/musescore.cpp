@@ -147,6 +147,7 @@ int trimMargin = -1;
 bool noWebView = false;
 bool exportScoreParts = false;
 bool ignoreWarnings = false;
+static int converterJobs = 1;
 
 QString mscoreGlobalShare;
 
@@ -156,6 +157,7 @@ static QString audioDriver;
 static QString pluginName;
 static QString styleFile;
 static bool scoresOnCommandline { false };
+static QElapsedTimer startupTimer;        // reports the time to the first layout of a conversion
 
 static QList<QTranslator*> translatorList;
 
@@ -549,7 +551,7 @@ MuseScore::MuseScore()
                   guiScaling = 1.0;
             }
 
-      MScore::pixelRatio = DPI / screen->logicalDotsPerInch();
+      MScore::setDefaultPixelRatio(DPI / screen->logicalDotsPerInch());
 
       setObjectName("MuseScore");
       _sstate = STATE_INIT;
@@ -2467,6 +2469,20 @@ static void loadScores(const QStringList& argv)
       mscore->setCurrentView(1, currentScoreView);
       }
 
+//---------------------------------------------------------
+//   jobMutex
+//    Serializes everything in a job which touches process
+//    global state: importers other than the native format,
+//    and exporters other than the native format (vector
+//    output shares the lazily created fonts of ScoreFont,
+//    audio the synthesizer, position files a static table).
+//    Pages of a PNG export are painted in parallel anyway.
+//    Reading, laying out and saving .mscz/.mscx files runs
+//    unlocked.
+//---------------------------------------------------------
+
+static QMutex jobMutex;
+
 //---------------------------------------------------------
 //   doConvert
 //---------------------------------------------------------
@@ -2487,6 +2503,8 @@ static bool doConvert(Score* cs, QString fn)
             if (f.open(QIODevice::ReadOnly))
                   cs->style()->load(&f);
             }
+      bool native = fn.endsWith(".mscx") || fn.endsWith(".mscz");
+      QMutexLocker locker(native ? 0 : &jobMutex);
       if (fn.endsWith(".mscx")) {
             QFileInfo fi(fn);
             if (!cs->saveFile(fi))
@@ -2569,8 +2587,11 @@ static bool doConvert(Score* cs, QString fn)
             rv = mscore->saveSvg(cs, fn);
             }
 #ifdef HAS_AUDIOFILE
-            else if (fn.endsWith(".wav") || fn.endsWith(".ogg") || fn.endsWith(".flac"))
+            else if (fn.endsWith(".wav") || fn.endsWith(".ogg") || fn.endsWith(".flac")) {
+                  if (exportScoreParts)
+                        return mscore->saveAudioParts(cs, fn);
                   return mscore->saveAudio(cs, fn);
+                  }
 #endif
 #ifdef USE_LAME
             else if (fn.endsWith(".mp3"))
@@ -2609,6 +2630,11 @@ static bool convert(const QString& inFile, const QString& outFile)
       MasterScore* score = mscore->readScore(inFile);
       if (!score)
             return false;
+      if (startupTimer.isValid()) {
+            if (MScore::debugMode)
+                  qDebug("first layout after %lld ms", startupTimer.elapsed());
+            startupTimer.invalidate();
+            }
       if (!doConvert(score, outFile)) {
             delete score;
             return false;
@@ -2617,8 +2643,99 @@ static bool convert(const QString& inFile, const QString& outFile)
       return true;
       }
 
+//---------------------------------------------------------
+//   ConvertJob
+//    one entry of a -j job file
+//---------------------------------------------------------
+
+struct ConvertJob {
+      QString inFile;
+      QString outFile;
+      bool ok       { false };
+      qint64 readMs { 0 };
+      qint64 convertMs { 0 };
+      QString error;
+      };
+
+static QMutex jobReportMutex;
+
+//---------------------------------------------------------
+//   readJobScore
+//    thread safe variant of MuseScore::readScore() for
+//    converter mode
+//---------------------------------------------------------
+
+static MasterScore* readJobScore(ConvertJob* job)
+      {
+      QString suffix = QFileInfo(job->inFile).suffix().toLower();
+      bool native = suffix == "mscz" || suffix == "mscx";
+      if (!native)
+            jobMutex.lock();
+
+      MasterScore* score = new MasterScore(MScore::baseStyle());
+      Score::FileError rv = Ms::readScore(score, job->inFile, false);
+      if (ignoreWarnings && (rv == Score::FileError::FILE_TOO_OLD || rv == Score::FileError::FILE_TOO_NEW)) {
+            delete score;
+            score = new MasterScore(MScore::baseStyle());
+            rv = Ms::readScore(score, job->inFile, true);
+            }
+      else if (ignoreWarnings && rv == Score::FileError::FILE_CORRUPTED)
+            rv = Score::FileError::FILE_NO_ERROR;
+
+      if (!native)
+            jobMutex.unlock();
+
+      if (rv != Score::FileError::FILE_NO_ERROR) {
+            job->error = QString("cannot read file, error %1").arg(int(rv));
+            delete score;
+            return 0;
+            }
+      return score;
+      }
+
+//---------------------------------------------------------
+//   runJob
+//---------------------------------------------------------
+
+static void runJob(ConvertJob& job)
+      {
+      QElapsedTimer timer;
+      timer.start();
+      if (job.inFile.isEmpty() || job.outFile.isEmpty())
+            job.error = "missing in or out file";
+      else {
+            fprintf(stderr, "convert <%s> to <%s>\n", qPrintable(job.inFile), qPrintable(job.outFile));
+            MasterScore* score = readJobScore(&job);
+            job.readMs = timer.restart();
+            if (score) {
+                  job.ok = doConvert(score, job.outFile);
+                  if (!job.ok)
+                        job.error = "conversion failed";
+                  delete score;
+                  }
+            job.convertMs = timer.elapsed();
+            }
+
+      QJsonObject report;
+      report["in"]      = job.inFile;
+      report["out"]     = job.outFile;
+      report["status"]  = job.ok ? "ok" : "error";
+      report["read"]    = job.readMs;
+      report["convert"] = job.convertMs;
+      if (!job.ok)
+            report["error"] = job.error;
+      QMutexLocker locker(&jobReportMutex);
+      fprintf(stdout, "%s\n", QJsonDocument(report).toJson(QJsonDocument::Compact).constData());
+      fflush(stdout);
+      }
+
 //---------------------------------------------------------
 //   doProcessJob
+//    A failing entry is reported and does not abort the
+//    batch; returns false if any entry failed.
+//    With --jobs N the entries are spread over a pool of
+//    N worker threads. Every worker reads its own MasterScore;
+//    the score fonts are loaded up front and shared read only.
 //---------------------------------------------------------
 
 static bool doProcessJob(QString jsonFile)
@@ -2640,9 +2757,9 @@ static bool doProcessJob(QString jsonFile)
             return false;
             }
       QJsonArray a = doc.array();
+      QVector<ConvertJob> jobs;
       for (const auto i : a) {
-            QString inFile;
-            QString outFile;
+            ConvertJob job;
             if (!i.isObject()) {
                   fprintf(stderr, "array value is not an object\n");
                   return false;
@@ -2651,18 +2768,36 @@ static bool doProcessJob(QString jsonFile)
             for (const auto& key : obj.keys()) {
                   QString val = obj.value(key).toString();
                   if (key == "in")
-                        inFile = val;
+                        job.inFile = val;
                   else if (key == "out")
-                        outFile = val;
+                        job.outFile = val;
                   else {
                         fprintf(stderr, "unknown key <%s>\n", qPrintable(key));
                         return false;
                         }
                   }
-            if (!convert(inFile, outFile))
-                  return false;
+            jobs.append(job);
             }
-      return true;
+
+      if (converterJobs > 1) {
+            // load all score fonts now, workers only read them
+            for (const ScoreFont& sf : ScoreFont::scoreFonts())
+                  ScoreFont::fontFactory(sf.name());
+            QThreadPool pool;
+            pool.setMaxThreadCount(converterJobs);
+            for (ConvertJob& job : jobs)
+                  QtConcurrent::run(&pool, [&job]() { runJob(job); });
+            pool.waitForDone();
+            }
+      else {
+            for (ConvertJob& job : jobs)
+                  runJob(job);
+            }
+
+      bool rv = true;
+      for (const ConvertJob& job : jobs)
+            rv = rv && job.ok;
+      return rv;
       }
 
 //---------------------------------------------------------
@@ -2765,6 +2900,11 @@ MasterSynthesizer* synthesizerFactory()
       // ms->registerEffect(1, new Freeverb);
       ms->setEffect(0, 1);
       ms->setEffect(1, 0);
+
+      int threads = preferences.synthesizerThreads;
+      if (threads < 0)
+            threads = qBound(0, QThread::idealThreadCount() - 1, 3);
+      ms->setThreads(threads);
       return ms;
       }
 
@@ -5256,6 +5396,7 @@ using namespace Ms;
 
 int main(int argc, char* av[])
       {
+      startupTimer.start();
 #ifndef NDEBUG
       qSetMessagePattern("%{file}:%{function}: %{message}");
       checkProperties();
@@ -5320,12 +5461,13 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption({"R", "revert-settings"}, "Revert to default preferences"));
       parser.addOption(QCommandLineOption({"i", "load-icons"}, "Load icons from INSTALLPATH/icons"));
       parser.addOption(QCommandLineOption({"j", "job"}, "process a conversion job", "file"));
+      parser.addOption(QCommandLineOption(      "jobs", "Used with -j, number of parallel conversion workers", "N"));
       parser.addOption(QCommandLineOption({"e", "experimental"}, "Enable experimental features"));
       parser.addOption(QCommandLineOption({"c", "config-folder"}, "Override config/settings folder", "dir"));
       parser.addOption(QCommandLineOption({"t", "test-mode"}, "Set testMode flag for all files"));
       parser.addOption(QCommandLineOption({"M", "midi-operations"}, "Specify MIDI import operations file", "file"));
       parser.addOption(QCommandLineOption({"w", "no-webview"}, "No web view in start center"));
-      parser.addOption(QCommandLineOption({"P", "export-score-parts"}, "Used with -o <file>.pdf, export score + parts"));
+      parser.addOption(QCommandLineOption({"P", "export-score-parts"}, "Used with -o <file>.pdf or .png, export score + parts; with an audio file, export one file per part"));
       parser.addOption(QCommandLineOption(      "no-fallback-font", "will not use Bravura as fallback musical font"));
       parser.addOption(QCommandLineOption({"f", "force"}, "Used with -o, ignore warnings reg. score being corrupted or from wrong version"));
 
@@ -5368,6 +5510,17 @@ int main(int argc, char* av[])
                   parser.showHelp(EXIT_FAILURE);
                   }
             }
+      MScore::parallelLayout = converterMode;
+      if (parser.isSet("jobs")) {
+            if (!processJob)
+                  parser.showHelp(EXIT_FAILURE);
+            bool ok = false;
+            converterJobs = parser.value("jobs").toInt(&ok);
+            if (!ok || converterJobs < 1) {
+                  fprintf(stderr, "--jobs: bad number of workers\n");
+                  parser.showHelp(EXIT_FAILURE);
+                  }
+            }
       if ((pluginMode = parser.isSet("p"))) {
             MScore::noGui = true;
             pluginName = parser.value("p");
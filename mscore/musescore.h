@@ -446,6 +446,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
 
       void updateViewModeCombo();
       void switchLayoutMode(LayoutMode);
+      bool renderAudio(Score*, const QStringList& names, bool parts);
 
    private slots:
       void cmd(QAction* a, const QString& cmd);
@@ -645,6 +646,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
 
       bool savePng(Score*, const QString& name, bool screenshot, bool transparent, double convDpi, int trimMargin, QImage::Format format);
       bool saveAudio(Score*, const QString& name);
+      bool saveAudioParts(Score*, const QString& name);
       bool saveMp3(Score*, const QString& name);
       bool saveSvg(Score*, const QString& name);
       bool savePng(Score*, const QString& name);
@@ -187,6 +187,8 @@ void Preferences::init()
       myTemplatesPath = QFileInfo(QString("%1/%2").arg(wd).arg(QCoreApplication::translate("templates_directory",  "Templates"))).absoluteFilePath();
       myPluginsPath   = QFileInfo(QString("%1/%2").arg(wd).arg(QCoreApplication::translate("plugins_directory",    "Plugins"))).absoluteFilePath();
       mySoundfontsPath = QFileInfo(QString("%1/%2").arg(wd).arg(QCoreApplication::translate("soundfonts_directory", "Soundfonts"))).absoluteFilePath();
+      zerberusStreaming = false;
+      synthesizerThreads = 0;
 
       MScore::setNudgeStep(.1);         // cursor key (default 0.1)
       MScore::setNudgeStep10(1.0);      // Ctrl + cursor key (default 1.0)
@@ -332,6 +334,8 @@ void Preferences::write()
       s.setValue("myTemplatesPath", myTemplatesPath);
       s.setValue("myPluginsPath", myPluginsPath);
       s.setValue("mySoundfontsPath", mySoundfontsPath);
+      s.setValue("zerberusStreaming", zerberusStreaming);
+      s.setValue("synthesizerThreads", synthesizerThreads);
 
       s.setValue("hraster", MScore::hRaster());
       s.setValue("vraster", MScore::vRaster());
@@ -493,6 +497,8 @@ void Preferences::read()
       myTemplatesPath  = s.value("myTemplatesPath",  myTemplatesPath).toString();
       myPluginsPath    = s.value("myPluginsPath",    myPluginsPath).toString();
       mySoundfontsPath = s.value("mySoundfontsPath", mySoundfontsPath).toString();
+      zerberusStreaming = s.value("zerberusStreaming", zerberusStreaming).toBool();
+      synthesizerThreads = s.value("synthesizerThreads", synthesizerThreads).toInt();
 
       //Create directories if they are missing
       QDir dir;
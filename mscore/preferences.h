@@ -173,6 +173,8 @@ struct Preferences {
       QString myTemplatesPath;
       QString myPluginsPath;
       QString mySoundfontsPath;
+      bool zerberusStreaming;       // keep only the head of long sfz samples in memory
+      int synthesizerThreads;       // threads helping the audio thread to render voices, 0: none (default), -1: automatic
 
       bool nativeDialogs;
 
@@ -1712,7 +1712,10 @@ void ScoreView::paintEvent(QPaintEvent* ev)
       vp.setRenderHint(QPainter::Antialiasing, preferences.antialiasedDrawing);
       vp.setRenderHint(QPainter::TextAntialiasing, true);
 
+      QElapsedTimer timer;
+      timer.start();
       paint(ev->rect(), vp);
+      updatePaintStats(timer.nsecsElapsed());
 
       vp.setTransform(_matrix);
       vp.setClipping(false);
@@ -1774,6 +1777,24 @@ void ScoreView::paintEvent(QPaintEvent* ev)
             }
       }
 
+//---------------------------------------------------------
+//   updatePaintStats
+//    collect the time spent drawing the score; reported
+//    every 100 repaints in debug mode
+//---------------------------------------------------------
+
+void ScoreView::updatePaintStats(qint64 ns)
+      {
+      ++_paintStats.frames;
+      _paintStats.totalNs += ns;
+      _paintStats.maxNs    = qMax(_paintStats.maxNs, ns);
+      if (MScore::debugMode && _paintStats.frames == 100) {
+            qDebug("ScoreView::paint: %d repaints, avg %.2f ms, max %.2f ms",
+               _paintStats.frames, _paintStats.totalNs / (_paintStats.frames * 1e6), _paintStats.maxNs / 1e6);
+            _paintStats = PaintStats();
+            }
+      }
+
 //---------------------------------------------------------
 //   drawBackground
 //---------------------------------------------------------
@@ -1913,9 +1934,7 @@ void ScoreView::paint(const QRect& r, QPainter& p)
       if ((_score->layoutMode() == LayoutMode::LINE) || (_score->layoutMode() == LayoutMode::SYSTEM)) {
             if (_score->pages().size() > 0) {
                   Page* page = _score->pages().front();
-                  QList<Element*> ell = page->items(fr);
-                  qStableSort(ell.begin(), ell.end(), elementLessThan);
-                  drawElements(p, ell);
+                  drawDisplayList(p, page->displayList(), fr);
                   }
             }
       else {
@@ -1928,11 +1947,9 @@ void ScoreView::paint(const QRect& r, QPainter& p)
                   if (pr.left() > fr.right())
                         break;
 
-                  QList<Element*> ell = page->items(fr.translated(-page->pos()));
-                  qStableSort(ell.begin(), ell.end(), elementLessThan);
                   QPointF pos(page->pos());
                   p.translate(pos);
-                  drawElements(p, ell);
+                  drawDisplayList(p, page->displayList(), fr.translated(-pos));
 
 #ifndef NDEBUG
                   if (!score()->printing()) {
@@ -2441,23 +2458,43 @@ static void drawDebugInfo(QPainter& p, const Element* _e)
 //   drawElements
 //---------------------------------------------------------
 
-void ScoreView::drawElements(QPainter& painter, const QList<Element*>& el)
+void ScoreView::drawElements(QPainter& painter, const std::vector<Element*>& el)
       {
-      for (const Element* e : el) {
-            e->itemDiscovered = 0;
-            if (!e->visible() && (score()->printing() || !score()->showInvisible()))
-                  continue;
-            if (e->isRest() && toRest(e)->isGap())
-                  continue;
-            QPointF pos(e->pagePos());
-            painter.translate(pos);
-            e->draw(&painter);
-            painter.translate(-pos);
+      for (const Element* e : el)
+            drawElement(painter, e, e->pagePos());
+      }
+
+//---------------------------------------------------------
+//   drawDisplayList
+//    draw the elements of a page display list which
+//    intersect r (page coordinates)
+//---------------------------------------------------------
+
+void ScoreView::drawDisplayList(QPainter& painter, const std::vector<DisplayItem>& dl, const QRectF& r)
+      {
+      for (const DisplayItem& di : dl) {
+            if (di.box.intersects(r))
+                  drawElement(painter, di.element, di.pos);
+            }
+      }
+
+//---------------------------------------------------------
+//   drawElement
+//---------------------------------------------------------
+
+void ScoreView::drawElement(QPainter& painter, const Element* e, const QPointF& pos)
+      {
+      if (!e->visible() && (score()->printing() || !score()->showInvisible()))
+            return;
+      if (e->isRest() && toRest(e)->isGap())
+            return;
+      painter.translate(pos);
+      e->draw(&painter);
+      painter.translate(-pos);
 #ifndef NDEBUG
-            if (e->selected())
-                  drawDebugInfo(painter, e);
+      if (e->selected())
+            drawDebugInfo(painter, e);
 #endif
-            }
       }
 
 //---------------------------------------------------------
@@ -6191,7 +6228,6 @@ Element* ScoreView::elementNear(QPointF p)
       QList<Element*> el = page->items(r);
       QList<Element*> ll;
       foreach (Element* e, el) {
-            e->itemDiscovered = 0;
             if (!e->selectable() || e->type() == Element::Type::PAGE)
                   continue;
             if (e->contains(p))
@@ -34,6 +34,7 @@ class ChordRest;
 class Rest;
 class Element;
 class Page;
+struct DisplayItem;
 class Xml;
 class Note;
 class Lasso;
@@ -191,6 +192,13 @@ class ScoreView : public QWidget, public MuseScoreView {
       Lasso* lasso;           ///< temporarily drawn lasso selection
       Lasso* _foto;
 
+      struct PaintStats {
+            int frames     { 0 };
+            qint64 totalNs { 0 };
+            qint64 maxNs   { 0 };
+            };
+      PaintStats _paintStats;             ///< repaint latency
+
       QColor _bgColor;
       QColor _fgColor;
       QPixmap* _bgPixmap;
@@ -222,7 +230,10 @@ class ScoreView : public QWidget, public MuseScoreView {
       void lassoSelect();
 
       void setShadowNote(const QPointF&);
-      void drawElements(QPainter& p,const QList<Element*>& el);
+      void drawElements(QPainter& p, const std::vector<Element*>& el);
+      void drawDisplayList(QPainter& p, const std::vector<DisplayItem>& dl, const QRectF& r);
+      void drawElement(QPainter& p, const Element* e, const QPointF& pos);
+      void updatePaintStats(qint64 ns);
       bool dragTimeAnchorElement(const QPointF& pos);
       bool dragMeasureAnchorElement(const QPointF& pos);
       void updateGrips();
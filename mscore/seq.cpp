@@ -214,6 +214,7 @@ void Seq::setScoreView(ScoreView* v)
       playlistChanged = true;
       _synti->reset();
       if (cs) {
+            cs->setPlayAllDirty();        // events were rendered for another score
             initInstruments();
             connect(cs, SIGNAL(playlistChanged()), this, SLOT(setPlaylistChanged()));
             }
@@ -986,10 +987,9 @@ void Seq::collectEvents()
       //do not collect even while playing
       if (state ==  Transport::PLAY)
             return;
-      events.clear();
 
       mutex.lock();
-      cs->renderMidi(&events);
+      cs->updateMidi(&events);
       endTick = 0;
 
       if (!events.empty()) {
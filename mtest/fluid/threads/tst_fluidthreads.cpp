@@ -0,0 +1,271 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include <cmath>
+
+#include "mtest/testutils.h"
+
+#include "fluid/fluid.h"
+#include "synthesizer/msynthesizer.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestFluidThreads
+//    the voices of a Fluid synthesizer rendered by
+//    several threads
+//---------------------------------------------------------
+
+class TestFluidThreads : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QTemporaryDir dir;
+      QString sfPath;
+
+      MasterSynthesizer* createSynth(int threads);
+      void render(MasterSynthesizer*, float* out, int frames);
+      void compare(const QVector<float>&, const QVector<float>&, float tolerance);
+
+   private slots:
+      void initTestCase();
+      void deterministic();
+      void sameAsSerial();
+      void parkedWorkers();
+      };
+
+static const int CHORDS       = 16;
+static const int CHORD_FRAMES = 44100 / 8;
+static const int HOLD_FRAMES  = 44100 / 2;
+static const int TOTAL_FRAMES = CHORDS * CHORD_FRAMES + HOLD_FRAMES + 44100 / 2;
+static const int SAMPLES      = 1024;
+
+//---------------------------------------------------------
+//   SfData
+//    little endian sound font data
+//---------------------------------------------------------
+
+struct SfData {
+      QByteArray data;
+      QDataStream ds;
+
+      SfData() : ds(&data, QIODevice::WriteOnly) { ds.setByteOrder(QDataStream::LittleEndian); }
+      template <typename T> SfData& operator<<(T val) { ds << val; return *this; }
+      SfData& name(const char* s) {
+            QByteArray n = QByteArray(s).leftJustified(20, '\0', true);
+            ds.writeRawData(n.constData(), 20);
+            return *this;
+            }
+      };
+
+//---------------------------------------------------------
+//   chunk
+//    a RIFF chunk; the type of a LIST chunk is the first
+//    four bytes of its data
+//---------------------------------------------------------
+
+static QByteArray chunk(const char* id, const QByteArray& data)
+      {
+      SfData d;
+      d.ds.writeRawData(id, 4);
+      d << quint32(data.size());
+      return d.data + data;
+      }
+
+//---------------------------------------------------------
+//   writeSoundFont
+//    a minimal sound font: one preset with one instrument
+//    playing one looped sample over the whole key range
+//---------------------------------------------------------
+
+static bool writeSoundFont(const QString& path)
+      {
+      SfData smpl;
+      for (int i = 0; i < SAMPLES; ++i)
+            smpl << qint16(qRound(16000 * std::sin(2 * M_PI * i * 8 / SAMPLES)));
+      for (int i = 0; i < 46; ++i)             // zero padding required after every sample
+            smpl << qint16(0);
+
+      // preset header: name, preset, bank, bag index, library, genre, morphology
+      SfData phdr;
+      phdr.name("Sine") << quint16(0) << quint16(0) << quint16(0) << quint32(0) << quint32(0) << quint32(0);
+      phdr.name("EOP")  << quint16(0) << quint16(0) << quint16(1) << quint32(0) << quint32(0) << quint32(0);
+      // bags: generator index, modulator index
+      SfData pbag;
+      pbag << quint16(0) << quint16(0) << quint16(1) << quint16(0);
+      SfData pgen;
+      pgen << quint16(41) << quint16(0) << quint32(0);                  // instrument 0
+      SfData inst;
+      inst.name("Sine") << quint16(0);
+      inst.name("EOI")  << quint16(1);
+      SfData ibag;
+      ibag << quint16(0) << quint16(0) << quint16(2) << quint16(0);
+      SfData igen;
+      igen << quint16(54) << quint16(1) << quint16(53) << quint16(0) << quint32(0);   // loop, sample 0
+      // sample header: name, start, end, loop start, loop end, rate, pitch, correction, link, type
+      SfData shdr;
+      shdr.name("Sine") << quint32(0) << quint32(SAMPLES) << quint32(0) << quint32(SAMPLES)
+                        << quint32(44100) << quint8(69) << qint8(0) << quint16(0) << quint16(1);
+      shdr.name("EOS")  << quint32(0) << quint32(0) << quint32(0) << quint32(0)
+                        << quint32(0) << quint8(0) << qint8(0) << quint16(0) << quint16(0);
+
+      SfData ifil;
+      ifil << quint16(2) << quint16(1);
+      QByteArray info = QByteArray("INFO") + chunk("ifil", ifil.data) + chunk("INAM", QByteArray("Sine", 4));
+      QByteArray sdta = QByteArray("sdta") + chunk("smpl", smpl.data);
+      QByteArray pdta = QByteArray("pdta")
+         + chunk("phdr", phdr.data) + chunk("pbag", pbag.data) + chunk("pmod", QByteArray(10, 0))
+         + chunk("pgen", pgen.data) + chunk("inst", inst.data) + chunk("ibag", ibag.data)
+         + chunk("imod", QByteArray(10, 0)) + chunk("igen", igen.data) + chunk("shdr", shdr.data);
+
+      QByteArray riff = chunk("RIFF", QByteArray("sfbk") + chunk("LIST", info) + chunk("LIST", sdta) + chunk("LIST", pdta));
+      QFile f(path);
+      if (!f.open(QIODevice::WriteOnly))
+            return false;
+      return f.write(riff) == riff.size();
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFluidThreads::initTestCase()
+      {
+      initMTest();
+      QVERIFY(dir.isValid());
+      sfPath = dir.path() + "/threadsTest.sf2";
+      QVERIFY(writeSoundFont(sfPath));
+      }
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+MasterSynthesizer* TestFluidThreads::createSynth(int threads)
+      {
+      MasterSynthesizer* ms = new MasterSynthesizer();
+      FluidS::Fluid* synth = new FluidS::Fluid();
+      ms->registerSynthesizer(synth);
+      ms->setSampleRate(44100);
+      ms->setThreads(threads);
+      if (!synth->addSoundFont(sfPath))
+            qFatal("cannot load %s", qPrintable(sfPath));
+      synth->setActive();
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      return ms;
+      }
+
+//---------------------------------------------------------
+//   render
+//    overlapping chords of eight notes in buffers of 64
+//    frames
+//---------------------------------------------------------
+
+void TestFluidThreads::render(MasterSynthesizer* ms, float* out, int frames)
+      {
+      static const int chord[] = { 36, 43, 48, 52, 55, 60, 64, 67 };
+      Synthesizer* synth = ms->synthesizer("Fluid");
+      for (int frame = 0; frame < frames; frame += 64) {
+            if (frame % CHORD_FRAMES < 64) {
+                  int n   = frame / CHORD_FRAMES;
+                  int off = n - HOLD_FRAMES / CHORD_FRAMES;
+                  if (off >= 0 && off < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + off % 12, 0));
+                        }
+                  if (n < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + n % 12, 100));
+                        }
+                  }
+            ms->process(qMin(64, frames - frame), out + frame * 2);
+            }
+      }
+
+//---------------------------------------------------------
+//   compare
+//---------------------------------------------------------
+
+void TestFluidThreads::compare(const QVector<float>& out1, const QVector<float>& out2, float tolerance)
+      {
+      float peak = 0.0;
+      for (int i = 0; i < out1.size(); ++i) {
+            peak = qMax(peak, qAbs(out1[i]));
+            if (qAbs(out1[i] - out2[i]) > tolerance)
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      QVERIFY(peak > 0.0);
+      }
+
+//---------------------------------------------------------
+//   deterministic
+//    the result must not depend on which thread renders
+//    which partition
+//---------------------------------------------------------
+
+void TestFluidThreads::deterministic()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      MasterSynthesizer* ms = createSynth(3);
+      render(ms, out1.data(), TOTAL_FRAMES);
+      delete ms;
+      ms = createSynth(3);
+      render(ms, out2.data(), TOTAL_FRAMES);
+      delete ms;
+      compare(out1, out2, 0.0);
+      }
+
+//---------------------------------------------------------
+//   sameAsSerial
+//    only the order of summation differs from the
+//    rendering on one thread
+//---------------------------------------------------------
+
+void TestFluidThreads::sameAsSerial()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      MasterSynthesizer* ms = createSynth(0);
+      render(ms, out1.data(), TOTAL_FRAMES);
+      delete ms;
+      ms = createSynth(3);
+      QCOMPARE(ms->threads(), 3);
+      render(ms, out2.data(), TOTAL_FRAMES);
+      delete ms;
+      compare(out1, out2, 1e-4);
+      }
+
+//---------------------------------------------------------
+//   parkedWorkers
+//    workers park while there is nothing to render and
+//    must help again with the next note
+//---------------------------------------------------------
+
+void TestFluidThreads::parkedWorkers()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 4);
+      QVector<float> out2(TOTAL_FRAMES * 4);
+      for (int threads : { 0, 3 }) {
+            MasterSynthesizer* ms = createSynth(threads);
+            float* out = threads ? out2.data() : out1.data();
+            render(ms, out, TOTAL_FRAMES);
+            QTest::qWait(100);      // all voices are released, the workers park
+            render(ms, out + TOTAL_FRAMES * 2, TOTAL_FRAMES);
+            delete ms;
+            }
+      compare(out1, out2, 1e-4);
+      }
+
+QTEST_MAIN(TestFluidThreads)
+
+#include "tst_fluidthreads.moc"
@@ -14,6 +14,9 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -40,6 +43,7 @@ class TestBenchmark : public QObject, public MTest
       void benchmark1();
       void benchmark2();
       void benchmark4();            // incremental layout (one page)
+      void rangeLayout();
       };
 
 //---------------------------------------------------------
@@ -90,6 +94,63 @@ void TestBenchmark::benchmark4()
             }
       }
 
+//---------------------------------------------------------
+//   systemLayout
+//    page, first measure and position of all systems
+//---------------------------------------------------------
+
+static QList<qreal> systemLayout(Score* score)
+      {
+      QList<qreal> l;
+      int systems = 0;
+      for (Page* page : score->pages()) {
+            l.append(page->systems().size());
+            for (System* system : page->systems()) {
+                  l.append(system->measures().front()->tick());
+                  l.append(system->y());
+                  ++systems;
+                  }
+            }
+      l.append(score->systems().size() - systems);
+      return l;
+      }
+
+//---------------------------------------------------------
+//   rangeLayout
+//    a range layout which shifts the system breaks must
+//    give the same result as a full layout
+//---------------------------------------------------------
+
+void TestBenchmark::rangeLayout()
+      {
+      MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      Measure* m = score->firstMeasure()->nextMeasure();
+      QList<qreal> before = systemLayout(score);
+
+      score->resetLayoutStats();
+      score->startCmd();
+      m->undoChangeProperty(P_ID::USER_STRETCH, 4.0);
+      score->endCmd();
+      QList<qreal> range = systemLayout(score);
+      QVERIFY(range != before);
+      // the range layout stops once the old systems are reached again
+      QCOMPARE(score->layoutStats().layouts, 1);
+      int rangeSystems = score->layoutStats().systems;
+      // obsolete systems are kept for reuse, no more are allocated
+      int allocated = score->systems().size() + score->freeSystems().size();
+      score->doLayout();
+      QCOMPARE(range, systemLayout(score));
+      QVERIFY(rangeSystems < score->systems().size() / 2);
+      QCOMPARE(score->systems().size() + score->freeSystems().size(), allocated);
+
+      score->undoRedo(true);
+      QCOMPARE(systemLayout(score), before);
+      QCOMPARE(score->systems().size() + score->freeSystems().size(), allocated);
+      delete score;
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
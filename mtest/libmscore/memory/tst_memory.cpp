@@ -0,0 +1,160 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/note.h"
+#include "libmscore/chord.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestMemory
+//    memory used by the undo history
+//---------------------------------------------------------
+
+class TestMemory : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase();
+      void undoCoalescing();
+      void undoLimit();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestMemory::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   notes
+//---------------------------------------------------------
+
+static QList<Note*> notes(Score* score)
+      {
+      QList<Note*> l;
+      for (Segment* s = score->firstSegment(Segment::Type::ChordRest); s; s = s->next1(Segment::Type::ChordRest)) {
+            for (Element* e : s->elist()) {
+                  if (e && e->isChord())
+                        l.append(toChord(e)->notes());
+                  }
+            }
+      return l;
+      }
+
+static void moveNote(Score* score, Note* note, qreal y, bool drag = false)
+      {
+      score->startCmd();
+      score->undoChangeProperty(note, P_ID::USER_OFF, QPointF(0.0, y));
+      if (drag)
+            score->undoStack()->setMergeable();
+      score->endCmd();
+      }
+
+//---------------------------------------------------------
+//   undoCoalescing
+//    repeated drags changing the same property are one
+//    undo step, other repeated changes are not
+//---------------------------------------------------------
+
+void TestMemory::undoCoalescing()
+      {
+      MasterScore* score = readScore("libmscore/midi/testBaroqueOrnaments.mscx");
+      QVERIFY(score);
+      UndoStack* undo = score->undoStack();
+      QList<Note*> nl = notes(score);
+      QVERIFY(nl.size() >= 2);
+      Note* n = nl[0];
+      QPointF off = n->userOff();
+
+      for (int i = 1; i <= 3; ++i)
+            moveNote(score, n, i, true);
+      QCOMPARE(undo->count(), 1);
+      moveNote(score, nl[1], 1.0, true);
+      QCOMPARE(undo->count(), 2);
+
+      score->undoRedo(true);
+      score->undoRedo(true);
+      QCOMPARE(n->userOff(), off);
+      score->undoRedo(false);
+      QCOMPARE(n->userOff(), QPointF(0.0, 3.0));
+
+      // the saved state must stay reachable
+      undo->setClean();
+      moveNote(score, n, 4.0, true);
+      QCOMPARE(undo->count(), 2);
+      score->undoRedo(true);
+      QVERIFY(undo->isClean());
+
+      // changes which are not drags are separate steps
+      moveNote(score, n, 5.0);
+      moveNote(score, n, 6.0);
+      QCOMPARE(undo->count(), 3);
+      score->undoRedo(true);
+      QCOMPARE(n->userOff(), QPointF(0.0, 5.0));
+      // a drag is not merged into a preceding change either
+      moveNote(score, n, 7.0, true);
+      QCOMPARE(undo->count(), 3);
+      moveNote(score, n, 8.0, true);
+      QCOMPARE(undo->count(), 3);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   undoLimit
+//    the oldest commands are dropped when the history
+//    is over budget
+//---------------------------------------------------------
+
+void TestMemory::undoLimit()
+      {
+      MasterScore* score = readScore("libmscore/midi/testBaroqueOrnaments.mscx");
+      QVERIFY(score);
+      UndoStack* undo = score->undoStack();
+      QList<Note*> nl = notes(score);
+      int n = qMin(nl.size(), 40);
+      QVERIFY(n >= 10);
+      QList<QPointF> offsets;
+      for (int i = 0; i < n; ++i) {
+            offsets.append(nl[i]->userOff());
+            moveNote(score, nl[i], 1.0);
+            }
+      QCOMPARE(undo->count(), n);
+      qint64 size = undo->memoryUsage();
+      QVERIFY(size > 0);
+      qDebug("undo history: %d commands, %lld bytes", undo->count(), size);
+
+      undo->setLimit(size / 2);
+      QVERIFY(undo->count() < n);
+      QVERIFY(undo->count() >= 1);
+      QVERIFY(undo->memoryUsage() <= size / 2);
+      QVERIFY(!undo->isClean());
+
+      int kept = undo->count();
+      while (undo->canUndo())
+            score->undoRedo(true);
+      for (int i = 0; i < n; ++i)
+            QCOMPARE(nl[i]->userOff(), i < n - kept ? QPointF(0.0, 1.0) : offsets[i]);
+      delete score;
+      }
+
+QTEST_MAIN(TestMemory)
+#include "tst_memory.moc"
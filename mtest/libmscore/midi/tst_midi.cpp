@@ -53,6 +53,8 @@ class TestMidi : public QObject, public MTest
       void midi03();
       void events_data();
       void events();
+      void updateMidi_data();
+      void updateMidi();
       void midiBendsExport1() { midiExportTestRef("testBends1"); }
       void midiBendsExport2() { midiExportTestRef("testBends2"); }      // Play property test
       void midiPortExport()   { midiExportTestRef("testMidiPort"); }
@@ -388,6 +390,78 @@ void TestMidi::events()
      // QVERIFY(saveCompareScore(score, writeFile, reference));
       }
 
+//---------------------------------------------------------
+//   eventList
+//    sorted textual form of an event map, the order of
+//    events at the same tick is not significant
+//---------------------------------------------------------
+
+static QStringList eventList(const EventMap& events)
+      {
+      QStringList l;
+      for (const auto& e : events) {
+            l.append(QString("%1 %2 %3 %4 %5").arg(e.first).arg(e.second.type())
+               .arg(e.second.channel()).arg(e.second.dataA()).arg(e.second.dataB()));
+            }
+      l.sort();
+      return l;
+      }
+
+//---------------------------------------------------------
+//   updateMidi
+//    incremental rendering after an edit and after its
+//    undo must give the same events as a full render
+//---------------------------------------------------------
+
+void TestMidi::updateMidi_data()
+      {
+      QTest::addColumn<QString>("file");
+      QTest::newRow("testSwing8thTies") <<  "testSwing8thTies";
+      QTest::newRow("testSwingTexts") <<  "testSwingTexts";
+      QTest::newRow("testTieTrill") << "testTieTrill";
+      QTest::newRow("testPedal") <<  "testPedal";
+      QTest::newRow("testKantataBWV140Excerpts") <<  "testKantataBWV140Excerpts";
+      }
+
+void TestMidi::updateMidi()
+      {
+      QFETCH(QString, file);
+
+      MasterScore* score = readScore(DIR + file + ".mscx");
+      QVERIFY(score);
+      EventMap events;
+      score->updateMidi(&events);
+
+      // pick the first note in the middle of the score
+      Measure* m = score->firstMeasure();
+      for (int i = score->nmeasures() / 2; i > 0; --i)
+            m = m->nextMeasure();
+      Note* note = 0;
+      for (Segment* s = m->first(Segment::Type::ChordRest); s && !note; s = s->next(Segment::Type::ChordRest)) {
+            Element* e = s->element(0);
+            if (e && e->type() == Element::Type::CHORD)
+                  note = static_cast<Chord*>(e)->upNote();
+            }
+      QVERIFY(note);
+
+      score->startCmd();
+      note->undoChangeProperty(P_ID::PITCH, note->pitch() + 1);
+      score->endCmd();
+
+      EventMap full;
+      score->updateMidi(&events);
+      score->renderMidi(&full);
+      QCOMPARE(eventList(events), eventList(full));
+
+      score->undoRedo(true);
+      full.clear();
+      score->updateMidi(&events);
+      score->renderMidi(&full);
+      QCOMPARE(eventList(events), eventList(full));
+
+      delete score;
+      }
+
 //---------------------------------------------------------
 //   midiExportTest
 //   read a MuseScore mscx file, write to a MIDI file and verify against reference
@@ -23,6 +23,7 @@
 #include "libmscore/tremolo.h"
 #include "libmscore/articulation.h"
 #include "libmscore/sym.h"
+#include "synthesizer/event.h"
 #include "mtest/testutils.h"
 
 #define DIR QString("libmscore/note/")
@@ -45,6 +46,7 @@ class TestNote : public QObject, public MTest
       void tpcTranspose();
       void tpcTranspose2();
       void noteLimits();
+      void propertyInvalidation();
       };
 
 //---------------------------------------------------------
@@ -483,6 +485,68 @@ void TestNote::noteLimits()
       QVERIFY(saveCompareScore(score, "notelimits-test.mscx", DIR + "notelimits-ref.mscx"));
       }
 
+//---------------------------------------------------------
+///   propertyInvalidation
+///   color and velocity changes must not request a layout
+//---------------------------------------------------------
+
+void TestNote::propertyInvalidation()
+      {
+      MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      Chord* chord = nullptr;
+      for (Segment* s = score->firstSegment(Segment::Type::ChordRest); s && !chord; s = s->next1(Segment::Type::ChordRest)) {
+            if (s->element(0) && s->element(0)->type() == Element::Type::CHORD)
+                  chord = static_cast<Chord*>(s->element(0));
+            }
+      QVERIFY(chord);
+      Note* note = chord->upNote();
+      const CmdState& cs = score->cmdState();
+
+      score->startCmd();
+      note->undoChangeProperty(P_ID::COLOR, QColor(Qt::red));
+      QVERIFY(!cs.layoutRange() && !cs.layoutAll());
+      QVERIFY(!cs.playRange());
+      QVERIFY(cs._renderChanged);
+      note->undoChangeProperty(P_ID::VELO_OFFSET, note->veloOffset() + 10);
+      QVERIFY(!cs.layoutRange() && !cs.layoutAll());
+      QVERIFY(cs.playRange());
+      QCOMPARE(cs.playStartTick(), note->tick());
+      note->undoChangeProperty(P_ID::SMALL, !note->small());
+      QVERIFY(cs.layoutRange());
+      score->endCmd();
+      QCOMPARE(note->color(), QColor(Qt::red));
+
+      // undo takes the same path
+      score->undoRedo(true);
+      QVERIFY(note->color() != QColor(Qt::red));
+      score->startCmd();
+      note->undoChangeProperty(P_ID::PLAY, false);
+      QVERIFY(!cs.layoutRange() && cs.playRange());
+      score->endCmd();
+      QVERIFY(!note->play());
+
+      // a velocity change in a command which also needs
+      // a full layout renders all play events again
+      EventMap events;
+      score->updateMidi(&events);
+      QVERIFY(!score->playAllDirty());
+      score->startCmd();
+      note->undoChangeProperty(P_ID::VELO_OFFSET, note->veloOffset() + 10);
+      score->setLayoutAll();
+      QVERIFY(cs.layoutAll() && cs.playRange());
+      score->endCmd();
+      QVERIFY(score->playAllDirty());
+
+      // a velocity change alone does not
+      score->updateMidi(&events);
+      score->startCmd();
+      note->undoChangeProperty(P_ID::VELO_OFFSET, note->veloOffset() + 10);
+      score->endCmd();
+      QVERIFY(!score->playAllDirty());
+      delete score;
+      }
+
 QTEST_MAIN(TestNote)
 
 #include "tst_note.moc"
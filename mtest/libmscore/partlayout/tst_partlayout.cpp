@@ -0,0 +1,211 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/part.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/measure.h"
+#include "libmscore/style.h"
+
+#define DIR QString("libmscore/concertpitch/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestPartLayout
+//    layout of a master score and its parts with
+//    Score::layoutScores(), serial and in parallel
+//---------------------------------------------------------
+
+class TestPartLayout : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterScore* score;
+      QList<Score*> scores;
+
+      QList<qreal> layoutResult() const;
+      qint64 layoutTime(bool parallel);
+      void verifyConcurrent() const;
+
+   private slots:
+      void initTestCase();
+      void cleanupTestCase();
+      void sameLayout();
+      void benchmark();
+      void multiMeasureRests();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    create 30 parts, every instrument of the score
+//    several times
+//---------------------------------------------------------
+
+void TestPartLayout::initTestCase()
+      {
+      static const int PARTS = 30;
+
+      initMTest();
+      score = readScore(DIR + "concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      scores.append(score);
+      for (int i = 0; i < PARTS; ++i) {
+            Part* part = score->parts().at(i % score->parts().size());
+            Score* nscore = new Score(score);
+            Excerpt* ex = new Excerpt(score);
+            ex->setPartScore(nscore);
+            ex->parts().append(part);
+            ex->setTitle(Excerpt::createName(part->partName(), score->excerpts()));
+            Excerpt::createExcerpt(ex);
+            score->excerpts().append(ex);
+            scores.append(nscore);
+            }
+      }
+
+void TestPartLayout::cleanupTestCase()
+      {
+      MScore::parallelLayout = false;
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   layoutResult
+//    number of pages and systems and the system positions
+//    of all scores
+//---------------------------------------------------------
+
+QList<qreal> TestPartLayout::layoutResult() const
+      {
+      QList<qreal> l;
+      for (Score* s : scores) {
+            l.append(s->pages().size());
+            for (Page* page : s->pages()) {
+                  l.append(page->systems().size());
+                  for (System* system : page->systems())
+                        l.append(system->y());
+                  }
+            }
+      return l;
+      }
+
+//---------------------------------------------------------
+//   layoutTime
+//---------------------------------------------------------
+
+qint64 TestPartLayout::layoutTime(bool parallel)
+      {
+      MScore::parallelLayout = parallel;
+      QElapsedTimer timer;
+      timer.start();
+      Score::layoutScores(scores);
+      return timer.elapsed();
+      }
+
+//---------------------------------------------------------
+//   verifyConcurrent
+//    all parts were laid out on the thread pool by the
+//    last parallel layout
+//---------------------------------------------------------
+
+void TestPartLayout::verifyConcurrent() const
+      {
+      if (QThreadPool::globalInstance()->maxThreadCount() < 2)
+            return;
+      for (Score* s : scores) {
+            if (!s->isMaster())
+                  QCOMPARE(s->layoutStats().concurrent, 1);
+            }
+      }
+
+//---------------------------------------------------------
+//   sameLayout
+//    the parts have multi measure rests turned on by
+//    default; they are created before the concurrent
+//    layout
+//---------------------------------------------------------
+
+void TestPartLayout::sameLayout()
+      {
+      layoutTime(false);
+      QList<qreal> serial = layoutResult();
+      for (Score* s : scores)
+            s->resetLayoutStats();
+      layoutTime(true);
+      QList<qreal> parallel = layoutResult();
+      QCOMPARE(parallel, serial);
+      verifyConcurrent();
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    compare serial and parallel layout of the score
+//    and its 30 parts
+//---------------------------------------------------------
+
+void TestPartLayout::benchmark()
+      {
+      static const int RUNS = 3;
+
+      qint64 serial   = 0;
+      qint64 parallel = 0;
+      for (int i = 0; i < RUNS; ++i) {
+            serial   += layoutTime(false);
+            parallel += layoutTime(true);
+            }
+      qDebug("layout of %d scores, %d threads: serial %lld ms, parallel %lld ms, speedup %.2f",
+         scores.size(), QThreadPool::globalInstance()->maxThreadCount(),
+         serial / RUNS, parallel / RUNS, parallel ? qreal(serial) / qreal(parallel) : 0.0);
+      }
+
+//---------------------------------------------------------
+//   multiMeasureRests
+//    multi measure rests are created with undo commands on
+//    the master score; they are created one by one before
+//    the parts are laid out concurrently
+//---------------------------------------------------------
+
+void TestPartLayout::multiMeasureRests()
+      {
+      // append empty measures without multi measure rests
+      for (Score* s : scores) {
+            if (!s->isMaster())
+                  s->style()->set(StyleIdx::createMultiMeasureRests, false);
+            }
+      score->startCmd();
+      for (int i = 0; i < 4; ++i)
+            score->insertMeasure(Element::Type::MEASURE, 0);
+      score->endCmd();
+      for (Score* s : scores) {
+            if (!s->isMaster())
+                  s->style()->set(StyleIdx::createMultiMeasureRests, true);
+            s->resetLayoutStats();
+            }
+
+      layoutTime(true);
+      QList<qreal> parallel = layoutResult();
+      verifyConcurrent();
+      for (Score* s : scores) {
+            if (!s->isMaster())
+                  QVERIFY(s->lastMeasure()->mmRestCount() < 0);
+            }
+      layoutTime(false);
+      QList<qreal> serial = layoutResult();
+      QCOMPARE(parallel, serial);
+      }
+
+QTEST_MAIN(TestPartLayout)
+#include "tst_partlayout.moc"
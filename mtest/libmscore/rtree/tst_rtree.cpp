@@ -0,0 +1,218 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/measure.h"
+#include "libmscore/rest.h"
+
+#define DIR QString("libmscore/concertpitch/")
+
+using namespace Ms;
+
+typedef std::vector<Element*> ElementList;
+
+//---------------------------------------------------------
+//   TestRTree
+//---------------------------------------------------------
+
+class TestRTree : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterScore* score;
+
+      void checkPage(Page* page, int queries);
+
+   private slots:
+      void initTestCase();
+      void rectQuery();
+      void pointQuery();
+      void updateInPlace();
+      void benchmarkRectQuery();
+      };
+
+//---------------------------------------------------------
+//   collect
+//---------------------------------------------------------
+
+static void collect(void* data, Element* e)
+      {
+      static_cast<ElementList*>(data)->push_back(e);
+      }
+
+static void normalize(ElementList* l)
+      {
+      std::sort(l->begin(), l->end());
+      l->erase(std::unique(l->begin(), l->end()), l->end());
+      }
+
+//---------------------------------------------------------
+//   refItems
+//    reference implementation, tests all page elements
+//---------------------------------------------------------
+
+static ElementList refItems(Page* page, const QRectF& r)
+      {
+      ElementList all;
+      page->scanElements(&all, collect, false);
+      ElementList l;
+      for (Element* e : all) {
+            if (e->pageBoundingRect().intersects(r))
+                  l.push_back(e);
+            }
+      normalize(&l);
+      return l;
+      }
+
+//---------------------------------------------------------
+//   randomRect
+//---------------------------------------------------------
+
+static QRectF randomRect(const QRectF& area)
+      {
+      qreal x = area.left() + area.width()  * (qrand() % 1000) / 1000.0;
+      qreal y = area.top()  + area.height() * (qrand() % 1000) / 1000.0;
+      qreal w = area.width()  * (qrand() % 300) / 1000.0;
+      qreal h = area.height() * (qrand() % 300) / 1000.0;
+      return QRectF(x, y, w, h);
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestRTree::initTestCase()
+      {
+      initMTest();
+      score = readScore(DIR + "concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      QVERIFY(!score->pages().empty());
+      qsrand(1);
+      }
+
+//---------------------------------------------------------
+//   checkPage
+//---------------------------------------------------------
+
+void TestRTree::checkPage(Page* page, int queries)
+      {
+      ElementList l;
+      for (int i = 0; i < queries; ++i) {
+            QRectF r = randomRect(page->bbox());
+            l.clear();
+            page->items(r, &l);
+            int n = int(l.size());
+            normalize(&l);
+            QCOMPARE(int(l.size()), n);         // no duplicates
+            QVERIFY(l == refItems(page, r));
+            }
+      }
+
+//---------------------------------------------------------
+//   rectQuery
+//---------------------------------------------------------
+
+void TestRTree::rectQuery()
+      {
+      for (Page* page : score->pages()) {
+            checkPage(page, 200);
+            ElementList l;
+            page->items(page->bbox(), &l);
+            normalize(&l);
+            QVERIFY(l == refItems(page, page->bbox()));
+            }
+      }
+
+//---------------------------------------------------------
+//   pointQuery
+//---------------------------------------------------------
+
+void TestRTree::pointQuery()
+      {
+      for (Page* page : score->pages()) {
+            ElementList all;
+            page->scanElements(&all, collect, false);
+            for (int i = 0; i < 200; ++i) {
+                  QRectF r = randomRect(page->bbox());
+                  QPointF p = r.topLeft();
+                  ElementList ref;
+                  for (Element* e : all) {
+                        QRectF b = e->pageBoundingRect();
+                        bool inBox = b.left() <= p.x() && p.x() <= b.right() && b.top() <= p.y() && p.y() <= b.bottom();
+                        if (inBox && e->contains(p))
+                              ref.push_back(e);
+                        }
+                  normalize(&ref);
+                  QList<Element*> ql = page->items(p);
+                  ElementList l(ql.begin(), ql.end());
+                  normalize(&l);
+                  QVERIFY(l == ref);
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   updateInPlace
+//    move rests around and check the tree still finds
+//    them without a rebuild
+//---------------------------------------------------------
+
+void TestRTree::updateInPlace()
+      {
+      Page* page = score->pages().front();
+      ElementList l;
+      page->items(page->bbox(), &l);      // make sure the tree is built
+
+      int moved = 0;
+      for (Element* e : l) {
+            if (!e->isRest())
+                  continue;
+            Rest* rest = toRest(e);
+            rest->setUserOff(QPointF(0.0, rest->spatium() * (moved % 2 ? 4.0 : -4.0)));
+            rest->layout();
+            page->updateBspTree(rest);
+
+            QRectF r = rest->pageBoundingRect().adjusted(-1.0, -1.0, 1.0, 1.0);
+            ElementList found;
+            page->items(r, &found);
+            QVERIFY(std::find(found.begin(), found.end(), rest) != found.end());
+            if (++moved == 8)
+                  break;
+            }
+      checkPage(page, 200);
+      }
+
+//---------------------------------------------------------
+//   benchmarkRectQuery
+//---------------------------------------------------------
+
+void TestRTree::benchmarkRectQuery()
+      {
+      Page* page = score->pages().front();
+      std::vector<QRectF> rects;
+      for (int i = 0; i < 1000; ++i)
+            rects.push_back(randomRect(page->bbox()));
+      ElementList l;
+      QBENCHMARK {
+            for (const QRectF& r : rects) {
+                  l.clear();
+                  page->items(r, &l);
+                  }
+            }
+      }
+
+QTEST_MAIN(TestRTree)
+#include "tst_rtree.moc"
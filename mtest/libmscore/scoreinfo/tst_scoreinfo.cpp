@@ -0,0 +1,180 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/scoreinfo.h"
+#include "libmscore/part.h"
+#include "libmscore/instrument.h"
+#include "libmscore/measure.h"
+#include "libmscore/staff.h"
+
+#define DIR QString("libmscore/concertpitch/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreInfo
+//    reading facets of a score file must give the same
+//    result as loading the whole score
+//---------------------------------------------------------
+
+class TestScoreInfo : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      void compare(const ScoreInfo& info, MasterScore* score, ScoreInfo::Facets facets);
+
+   private slots:
+      void initTestCase();
+      void mscx();
+      void mscz();
+      void metaOnly();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreInfo::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   measure
+//---------------------------------------------------------
+
+static Measure* measure(Score* score, int idx)
+      {
+      Measure* m = score->firstMeasure();
+      for (int i = 0; m && i < idx; ++i)
+            m = m->nextMeasure();
+      return m;
+      }
+
+//---------------------------------------------------------
+//   compare
+//---------------------------------------------------------
+
+void TestScoreInfo::compare(const ScoreInfo& info, MasterScore* score, ScoreInfo::Facets facets)
+      {
+      QVERIFY(info.mscVersion() > 0);
+      if (facets & ScoreInfo::Facet::META) {
+            QCOMPARE(info.programVersion(), score->mscoreVersion());
+            QVERIFY(!info.metaTags().empty());
+            for (auto i = info.metaTags().begin(); i != info.metaTags().end(); ++i)
+                  QCOMPARE(i.value(), score->metaTag(i.key()));
+            }
+      if (facets & ScoreInfo::Facet::PARTS) {
+            QCOMPARE(info.parts().size(), score->parts().size());
+            for (int i = 0; i < info.parts().size(); ++i) {
+                  const ScoreInfo::PartInfo& pi = info.parts()[i];
+                  Part* part = score->parts()[i];
+                  QCOMPARE(pi.name, part->partName());
+                  QCOMPARE(pi.staves, part->nstaves());
+                  QCOMPARE(pi.instrumentId, part->instrument()->instrumentId());
+                  QCOMPARE(pi.show, part->show());
+                  }
+            }
+      else
+            QVERIFY(info.parts().empty());
+      if (facets & ScoreInfo::Facet::MEASURES) {
+            QCOMPARE(info.measures(), score->nmeasures());
+            QVERIFY(!info.timeSigs().empty());
+            for (const ScoreInfo::TimeSigChange& ts : info.timeSigs()) {
+                  Measure* m = measure(score, ts.measure);
+                  QVERIFY(m);
+                  QCOMPARE(ts.numerator, m->timesig().numerator());
+                  QCOMPARE(ts.denominator, m->timesig().denominator());
+                  }
+            for (const ScoreInfo::KeyChange& k : info.keys()) {
+                  Measure* m = measure(score, k.measure);
+                  QVERIFY(m);
+                  QCOMPARE(k.key, int(score->staff(0)->key(m->tick())));
+                  }
+            }
+      else
+            QCOMPARE(info.measures(), 0);
+      }
+
+//---------------------------------------------------------
+//   mscx
+//---------------------------------------------------------
+
+void TestScoreInfo::mscx()
+      {
+      QString path = root + "/" + DIR + "concertpitchbenchmark.mscx";
+      ScoreInfo info;
+      QVERIFY(info.read(path) == Score::FileError::FILE_NO_ERROR);
+      MasterScore* score = readScore(DIR + "concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      compare(info, score, ScoreInfo::Facet::ALL);
+      QVERIFY(info.thumbnail().isNull());
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   mscz
+//---------------------------------------------------------
+
+void TestScoreInfo::mscz()
+      {
+      MasterScore* score = readScore(DIR + "concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      QFileInfo fi("scoreinfo.mscz");
+      QVERIFY(score->saveCompressedFile(fi, false));
+      delete score;
+      score = readCreatedScore(fi.filePath());
+      QVERIFY(score);
+
+      ScoreInfo info;
+      QVERIFY(info.read(fi.filePath()) == Score::FileError::FILE_NO_ERROR);
+      compare(info, score, ScoreInfo::Facet::ALL);
+      QVERIFY(!info.thumbnail().isNull());
+
+      ScoreInfo thumbnail;
+      QVERIFY(thumbnail.read(fi.filePath(), ScoreInfo::Facet::THUMBNAIL) == Score::FileError::FILE_NO_ERROR);
+      QVERIFY(!thumbnail.thumbnail().isNull());
+      QVERIFY(thumbnail.metaTags().empty());
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   metaOnly
+//    reading only meta tags and parts stops at the first
+//    staff
+//---------------------------------------------------------
+
+void TestScoreInfo::metaOnly()
+      {
+      QString path = root + "/" + DIR + "concertpitchbenchmark.mscx";
+      ScoreInfo::Facets facets = ScoreInfo::Facet::META | ScoreInfo::Facet::PARTS;
+
+      QElapsedTimer timer;
+      timer.start();
+      ScoreInfo info;
+      QVERIFY(info.read(path, facets) == Score::FileError::FILE_NO_ERROR);
+      qint64 infoTime = timer.nsecsElapsed();
+
+      timer.restart();
+      MasterScore* score = readScore(DIR + "concertpitchbenchmark.mscx");
+      qint64 loadTime = timer.nsecsElapsed();
+      QVERIFY(score);
+      compare(info, score, facets);
+      qDebug("meta and parts: %lld us, full load: %lld us", infoTime / 1000, loadTime / 1000);
+      delete score;
+      }
+
+QTEST_MAIN(TestScoreInfo)
+#include "tst_scoreinfo.moc"
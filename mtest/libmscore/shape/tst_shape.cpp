@@ -0,0 +1,189 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/mscore.h"
+#include "libmscore/shape.h"
+
+using namespace Ms;
+
+typedef std::vector<QRectF> RectList;
+
+//---------------------------------------------------------
+//   TestShape
+//---------------------------------------------------------
+
+class TestShape : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      std::vector<RectList> rects;
+      std::vector<Shape> shapes;
+
+   private slots:
+      void initTestCase();
+      void minHorizontalDistance();
+      void minVerticalDistance();
+      void addTranslate();
+      void benchmarkMinHorizontalDistance();
+      };
+
+//---------------------------------------------------------
+//   refMinHorizontalDistance
+//    reference implementation, compares all pairs
+//---------------------------------------------------------
+
+static qreal refMinHorizontalDistance(const RectList& s, const RectList& a)
+      {
+      qreal dist = -1000000.0;
+      for (const QRectF& r2 : a) {
+            qreal by1 = r2.top();
+            qreal by2 = r2.bottom();
+            for (const QRectF& r1 : s) {
+                  qreal ay1 = r1.top();
+                  qreal ay2 = r1.bottom();
+                  if (intersects(ay1, ay2, by1, by2)
+                     || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
+                     || ((r1.width() == 0.0) || (r2.width() == 0.0)))
+                        dist = qMax(dist, r1.right() - r2.left());
+                  }
+            }
+      return dist;
+      }
+
+//---------------------------------------------------------
+//   refMinVerticalDistance
+//---------------------------------------------------------
+
+static qreal refMinVerticalDistance(const RectList& s, const RectList& a)
+      {
+      qreal dist = -1000000.0;
+      for (const QRectF& r2 : a) {
+            qreal bx1 = r2.left();
+            qreal bx2 = r2.right();
+            for (const QRectF& r1 : s) {
+                  qreal ax1 = r1.left();
+                  qreal ax2 = r1.right();
+                  if (intersects(ax1, ax2, bx1, bx2))
+                        dist = qMax(dist, r1.bottom() - r2.top());
+                  }
+            }
+      return dist;
+      }
+
+//---------------------------------------------------------
+//   randomRect
+//    coordinates on a quarter spatium grid so that equal
+//    edges, zero width and zero height rectangles occur
+//---------------------------------------------------------
+
+static QRectF randomRect()
+      {
+      qreal x = (qrand() % 400 - 200) * 0.25;
+      qreal y = (qrand() % 200 - 100) * 0.25;
+      qreal w = (qrand() % 10) * 0.25;
+      qreal h = (qrand() % 12) * 0.25;
+      if (qrand() % 8 == 0)
+            h = (qrand() % 100) * 0.25;         // stems, barlines
+      if (qrand() % 50 == 0)
+            h = -h;
+      return QRectF(x, y, w, h);
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestShape::initTestCase()
+      {
+      initMTest();
+      qsrand(4711);
+      static const int sizes[] = { 0, 1, 2, 5, 9, 20, 50, 120, 300 };
+      for (int size : sizes) {
+            for (int n = 0; n < 4; ++n) {
+                  RectList l;
+                  Shape s;
+                  for (int i = 0; i < size; ++i) {
+                        QRectF r = randomRect();
+                        l.push_back(r);
+                        s.add(r);
+                        }
+                  rects.push_back(l);
+                  shapes.push_back(s);
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistance()
+      {
+      for (size_t i = 0; i < shapes.size(); ++i) {
+            for (size_t k = 0; k < shapes.size(); ++k)
+                  QCOMPARE(shapes[i].minHorizontalDistance(shapes[k]), refMinHorizontalDistance(rects[i], rects[k]));
+            }
+      }
+
+//---------------------------------------------------------
+//   minVerticalDistance
+//---------------------------------------------------------
+
+void TestShape::minVerticalDistance()
+      {
+      for (size_t i = 0; i < shapes.size(); ++i) {
+            for (size_t k = 0; k < shapes.size(); ++k)
+                  QCOMPARE(shapes[i].minVerticalDistance(shapes[k]), refMinVerticalDistance(rects[i], rects[k]));
+            }
+      }
+
+//---------------------------------------------------------
+//   addTranslate
+//    merged and translated shapes stay sorted
+//---------------------------------------------------------
+
+void TestShape::addTranslate()
+      {
+      const QPointF d(3.5, -7.25);
+      for (size_t i = 0; i + 1 < shapes.size(); ++i) {
+            Shape s(shapes[i]);
+            s.add(shapes[i + 1].translated(d));
+            RectList l(rects[i]);
+            for (const QRectF& r : rects[i + 1])
+                  l.push_back(r.translated(d));
+            QCOMPARE(s.size(), int(l.size()));
+            for (size_t k = 0; k < shapes.size(); ++k) {
+                  QCOMPARE(s.minHorizontalDistance(shapes[k]), refMinHorizontalDistance(l, rects[k]));
+                  QCOMPARE(shapes[k].minVerticalDistance(s), refMinVerticalDistance(rects[k], l));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmarkMinHorizontalDistance
+//---------------------------------------------------------
+
+void TestShape::benchmarkMinHorizontalDistance()
+      {
+      const Shape& a = shapes.back();
+      const Shape& b = shapes[shapes.size() - 2];
+      qreal sum = 0.0;
+      QBENCHMARK {
+            sum += a.minHorizontalDistance(b);
+            }
+      QVERIFY(sum != 0.0);
+      }
+
+QTEST_MAIN(TestShape)
+#include "tst_shape.moc"
@@ -0,0 +1,153 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/style.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestStyle
+//---------------------------------------------------------
+
+class TestStyle : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      void checkTypedValues(const MStyle& style);
+
+   private slots:
+      void initTestCase();
+      void typedValues();
+      void spatiumChange();
+      void changeRecord();
+      void benchmarkStyleP();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestStyle::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   checkTypedValues
+//    the typed arrays must match the QVariant values
+//---------------------------------------------------------
+
+void TestStyle::checkTypedValues(const MStyle& style)
+      {
+      qreal spatium = style.value(StyleIdx::spatium).toDouble();
+      for (int i = 0; i < int(StyleIdx::STYLES); ++i) {
+            StyleIdx idx = StyleIdx(i);
+            const char* type = MStyle::valueType(idx);
+            QVariant v = style.value(idx);
+            if (!strcmp(type, "Ms::Spatium")) {
+                  QCOMPARE(style.svalue(idx).val(), v.value<Spatium>().val());
+                  QCOMPARE(style.pvalue(idx), v.value<Spatium>().val() * spatium);
+                  }
+            else if (!strcmp(type, "double"))
+                  QCOMPARE(style.dvalue(idx), v.toDouble());
+            else if (!strcmp(type, "bool"))
+                  QCOMPARE(style.bvalue(idx), v.toBool());
+            else if (!strcmp(type, "int"))
+                  QCOMPARE(style.ivalue(idx), v.toInt());
+            }
+      }
+
+//---------------------------------------------------------
+//   typedValues
+//---------------------------------------------------------
+
+void TestStyle::typedValues()
+      {
+      checkTypedValues(*MScore::baseStyle());
+      MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      checkTypedValues(*score->style());
+      MStyle copy(*score->style());
+      checkTypedValues(copy);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   spatiumChange
+//    all precomputed values follow a spatium change
+//---------------------------------------------------------
+
+void TestStyle::spatiumChange()
+      {
+      MStyle style(*MScore::baseStyle());
+      style.set(StyleIdx::spatium, style.value(StyleIdx::spatium).toDouble() * 1.5);
+      checkTypedValues(style);
+      style.set(StyleIdx::beamWidth, QVariant::fromValue(Spatium(0.75)));
+      checkTypedValues(style);
+      style.set(StyleIdx::beamNoSlope, !style.bvalue(StyleIdx::beamNoSlope));
+      checkTypedValues(style);
+      }
+
+//---------------------------------------------------------
+//   changeRecord
+//---------------------------------------------------------
+
+void TestStyle::changeRecord()
+      {
+      MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      score->styleChanged();
+      QVERIFY(!score->style()->changed());
+
+      bool noSlope = score->styleB(StyleIdx::beamNoSlope);
+      score->style()->set(StyleIdx::beamNoSlope, noSlope);
+      QVERIFY(!score->style()->changed());
+      score->style()->set(StyleIdx::beamNoSlope, !noSlope);
+      QVERIFY(score->style()->changed(StyleIdx::beamNoSlope));
+      QVERIFY(!score->style()->changed(StyleIdx::spatium));
+      score->styleChanged();
+      QVERIFY(!score->style()->changed());
+
+      MStyle s(*score->style());
+      s.set(StyleIdx::spatium, score->spatium() * 2.0);
+      s.clearChanged();
+      score->setStyle(s);
+      QVERIFY(score->style()->changed(StyleIdx::spatium));
+      QVERIFY(!score->style()->changed(StyleIdx::beamNoSlope));
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   benchmarkStyleP
+//---------------------------------------------------------
+
+void TestStyle::benchmarkStyleP()
+      {
+      MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QVERIFY(score);
+      qreal sum = 0.0;
+      QBENCHMARK {
+            for (int i = 0; i < 100000; ++i) {
+                  sum += score->styleP(StyleIdx::beamWidth);
+                  sum += score->styleD(StyleIdx::linearStretch);
+                  sum += score->styleB(StyleIdx::beamNoSlope);
+                  }
+            }
+      QVERIFY(sum > 0.0);
+      delete score;
+      }
+
+QTEST_MAIN(TestStyle)
+#include "tst_style.moc"
@@ -0,0 +1,145 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/mscore.h"
+#include "libmscore/tempo.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTempoMap
+//---------------------------------------------------------
+
+class TestTempoMap : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      TempoMap tm;
+
+   private slots:
+      void initTestCase();
+      void time2tick();
+      void roundTrip();
+      void benchmarkTime2tick();
+      void benchmarkTick2time();
+      };
+
+//---------------------------------------------------------
+//   linearTime2tick
+//    reference implementation, scans the whole map
+//---------------------------------------------------------
+
+static int linearTime2tick(const TempoMap& tm, qreal time)
+      {
+      int tick    = 0;
+      qreal delta = 0.0;
+      qreal tempo = 2.0;
+      for (auto e = tm.begin(); e != tm.end(); ++e) {
+            if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
+                  delta = (time - (e->second.time - e->second.pause) + delta);
+                  break;
+                  }
+            if (e->second.time >= time)
+                  break;
+            delta = e->second.time;
+            tick  = e->first;
+            tempo = e->second.tempo;
+            }
+      delta = time - delta;
+      tick += lrint(delta * tm.relTempo() * MScore::division * tempo);
+      return tick;
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//    a tempo map like a MIDI import with many rit./accel.
+//    ramps: a tempo event every eighth note and a pause
+//    at every 64th measure
+//---------------------------------------------------------
+
+void TestTempoMap::initTestCase()
+      {
+      initMTest();
+      const int eighth = MScore::division / 2;
+      for (int i = 0; i < 5000; ++i) {
+            qreal tempo = 1.5 + 0.5 * sin(i * 0.01);
+            tm.setTempo(i * eighth, tempo);
+            if (i % 512 == 0)
+                  tm.setPause(i * eighth, 0.75);
+            }
+      }
+
+//---------------------------------------------------------
+//   time2tick
+//---------------------------------------------------------
+
+void TestTempoMap::time2tick()
+      {
+      qreal endTime = tm.rbegin()->second.time + 10.0;
+      for (qreal t = 0.0; t < endTime; t += 0.0173)
+            QCOMPARE(tm.time2tick(t), linearTime2tick(tm, t));
+      // exact event times and pause boundaries
+      for (auto e = tm.begin(); e != tm.end(); ++e) {
+            qreal t = e->second.time;
+            QCOMPARE(tm.time2tick(t), linearTime2tick(tm, t));
+            t = e->second.time - e->second.pause;
+            QCOMPARE(tm.time2tick(t), linearTime2tick(tm, t));
+            }
+      }
+
+//---------------------------------------------------------
+//   roundTrip
+//---------------------------------------------------------
+
+void TestTempoMap::roundTrip()
+      {
+      for (int tick = 0; tick < tm.rbegin()->first; tick += 37) {
+            if (tm.find(tick) != tm.end() && tm.find(tick)->second.pause != 0.0)
+                  continue;
+            QCOMPARE(tm.time2tick(tm.tick2time(tick)), tick);
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmarkTime2tick
+//---------------------------------------------------------
+
+void TestTempoMap::benchmarkTime2tick()
+      {
+      qreal endTime = tm.rbegin()->second.time;
+      int sum = 0;
+      QBENCHMARK {
+            for (qreal t = 0.0; t < endTime; t += 0.01)
+                  sum += tm.time2tick(t);
+            }
+      QVERIFY(sum > 0);
+      }
+
+//---------------------------------------------------------
+//   benchmarkTick2time
+//---------------------------------------------------------
+
+void TestTempoMap::benchmarkTick2time()
+      {
+      int endTick = tm.rbegin()->first;
+      qreal sum = 0.0;
+      QBENCHMARK {
+            for (int tick = 0; tick < endTick; tick += 10)
+                  sum += tm.tick2time(tick);
+            }
+      QVERIFY(sum > 0.0);
+      }
+
+QTEST_MAIN(TestTempoMap)
+#include "tst_tempomap.moc"
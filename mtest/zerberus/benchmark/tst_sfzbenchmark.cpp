@@ -0,0 +1,156 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/voice.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSfzBenchmark
+//    renders a fixed passage: every eighth of a second a
+//    chord of eight notes starts which is held for two
+//    seconds
+//---------------------------------------------------------
+
+class TestSfzBenchmark : public QObject, public MTest
+      {
+      Q_OBJECT
+      float samplerate = 44100;
+
+      Zerberus* createSynth();
+      qint64 render(Zerberus*, int chunk, float* out);
+
+   private slots:
+      void initTestCase();
+      void blockSize();
+      void benchmark();
+      };
+
+static const int CHORDS       = 80;
+static const int CHORD_NOTES  = 8;
+static const int CHORD_FRAMES = 44100 / 8;
+static const int HOLD_FRAMES  = 2 * 44100;
+static const int TOTAL_FRAMES = CHORDS * CHORD_FRAMES + HOLD_FRAMES + 44100;
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzBenchmark::initTestCase()
+      {
+      initMTest();
+      Ms::preferences.mySoundfontsPath += ";" + root;
+      }
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+Zerberus* TestSfzBenchmark::createSynth()
+      {
+      Zerberus* synth = new Zerberus();
+      synth->init(samplerate);
+      synth->loadInstrument("benchmarkTest.sfz");
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      return synth;
+      }
+
+//---------------------------------------------------------
+//   render
+//    render the passage in pieces of chunk frames,
+//    return the number of rendered voice frames
+//---------------------------------------------------------
+
+qint64 TestSfzBenchmark::render(Zerberus* synth, int chunk, float* out)
+      {
+      static const int chord[CHORD_NOTES] = { 36, 43, 48, 52, 55, 60, 64, 67 };
+      qint64 voiceFrames = 0;
+      for (int frame = 0; frame < TOTAL_FRAMES;) {
+            // events are sent at multiples of CHORD_FRAMES
+            if (frame % CHORD_FRAMES == 0) {
+                  int n = frame / CHORD_FRAMES;
+                  int off = n - HOLD_FRAMES / CHORD_FRAMES;
+                  if (off >= 0 && off < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + off % 12, 0));
+                        }
+                  if (n < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + n % 12, 100));
+                        }
+                  }
+            int n = qMin(chunk, CHORD_FRAMES - frame % CHORD_FRAMES);
+            n = qMin(n, TOTAL_FRAMES - frame);
+            int voices = 0;
+            for (Voice* v = synth->getActiveVoices(); v; v = v->next())
+                  ++voices;
+            voiceFrames += qint64(voices) * n;
+            synth->process(n, out + frame * 2, nullptr, nullptr);
+            frame += n;
+            }
+      return voiceFrames;
+      }
+
+//---------------------------------------------------------
+//   blockSize
+//    the voices are rendered in blocks which are split at
+//    loop points and envelope stages; the result must not
+//    depend on the size of the audio buffer
+//---------------------------------------------------------
+
+void TestSfzBenchmark::blockSize()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      Zerberus* synth = createSynth();
+      render(synth, 256, out1.data());
+      delete synth;
+      synth = createSynth();
+      render(synth, 37, out2.data());
+      delete synth;
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            if (out1[i] != out2[i])
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    report how many voices one core can render in
+//    real time
+//---------------------------------------------------------
+
+void TestSfzBenchmark::benchmark()
+      {
+      QVector<float> out(TOTAL_FRAMES * 2);
+      Zerberus* synth = createSynth();
+      QElapsedTimer timer;
+      timer.start();
+      qint64 voiceFrames = render(synth, 256, out.data());
+      qint64 ns = timer.nsecsElapsed();
+      delete synth;
+      QVERIFY(voiceFrames > 0);
+      double voiceSeconds = double(voiceFrames) / samplerate;
+      double cpuSeconds   = ns / 1e9;
+      qDebug("rendered %.1f voice seconds in %.3f s: %.0f voices per core",
+         voiceSeconds, cpuSeconds, voiceSeconds / cpuSeconds);
+      }
+
+QTEST_MAIN(TestSfzBenchmark)
+
+#include "tst_sfzbenchmark.moc"
@@ -0,0 +1,136 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "synthesizer/msynthesizer.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSfzChannels
+//    every MIDI channel rendered to its own bus
+//---------------------------------------------------------
+
+class TestSfzChannels : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterSynthesizer* createSynth();
+      void play(MasterSynthesizer*, int frame);
+
+   private slots:
+      void initTestCase();
+      void separateChannels();
+      };
+
+static const int TOTAL_FRAMES = 44100;
+static const int BLOCK        = 256;
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzChannels::initTestCase()
+      {
+      initMTest();
+      Ms::preferences.mySoundfontsPath += ";" + root;
+      }
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+MasterSynthesizer* TestSfzChannels::createSynth()
+      {
+      MasterSynthesizer* ms = new MasterSynthesizer();
+      Zerberus* synth = new Zerberus();
+      ms->registerSynthesizer(synth);
+      ms->setSampleRate(44100);
+      synth->loadInstrument("channelsTest.sfz");
+      synth->setActive();
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 1, 0, 0));
+      return ms;
+      }
+
+//---------------------------------------------------------
+//   play
+//    a chord on channel 0 at the start, a note on
+//    channel 1 a bit later
+//---------------------------------------------------------
+
+void TestSfzChannels::play(MasterSynthesizer* ms, int frame)
+      {
+      Synthesizer* synth = ms->synthesizer("Zerberus");
+      if (frame == 0) {
+            synth->play(Ms::PlayEvent(ME_NOTEON, 0, 48, 100));
+            synth->play(Ms::PlayEvent(ME_NOTEON, 0, 55, 100));
+            }
+      else if (frame == 20 * BLOCK)
+            synth->play(Ms::PlayEvent(ME_NOTEON, 1, 67, 80));
+      else if (frame == 100 * BLOCK) {
+            synth->play(Ms::PlayEvent(ME_NOTEON, 0, 48, 0));
+            synth->play(Ms::PlayEvent(ME_NOTEON, 0, 55, 0));
+            synth->play(Ms::PlayEvent(ME_NOTEON, 1, 67, 0));
+            }
+      }
+
+//---------------------------------------------------------
+//   separateChannels
+//    the buses contain only the notes of their channel
+//    and add up to the mix
+//---------------------------------------------------------
+
+void TestSfzChannels::separateChannels()
+      {
+      QVector<float> mix(TOTAL_FRAMES * 2);
+      QVector<float> bus0(TOTAL_FRAMES * 2);
+      QVector<float> bus1(TOTAL_FRAMES * 2);
+
+      MasterSynthesizer* ms = createSynth();
+      for (int frame = 0; frame < TOTAL_FRAMES; frame += BLOCK) {
+            play(ms, frame);
+            ms->process(qMin(BLOCK, TOTAL_FRAMES - frame), mix.data() + frame * 2);
+            }
+      delete ms;
+
+      ms = createSynth();
+      for (int frame = 0; frame < TOTAL_FRAMES; frame += BLOCK) {
+            play(ms, frame);
+            float* bus[2] = { bus0.data() + frame * 2, bus1.data() + frame * 2 };
+            QVERIFY(ms->processChannels(qMin(BLOCK, TOTAL_FRAMES - frame), bus, 2));
+            }
+      delete ms;
+
+      float peak0 = 0.0;
+      float peak1 = 0.0;
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            peak0 = qMax(peak0, qAbs(bus0[i]));
+            if (i < 20 * BLOCK * 2)
+                  QCOMPARE(bus1[i], 0.0f);
+            else
+                  peak1 = qMax(peak1, qAbs(bus1[i]));
+            if (qAbs(mix[i] - (bus0[i] + bus1[i])) > 1e-4)
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(mix[i]).arg(bus0[i] + bus1[i])));
+            }
+      QVERIFY(peak0 > 0.0);
+      QVERIFY(peak1 > 0.0);
+      }
+
+QTEST_MAIN(TestSfzChannels)
+
+#include "tst_sfzchannels.moc"
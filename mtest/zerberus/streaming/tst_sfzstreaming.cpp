@@ -0,0 +1,212 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include <math.h>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/zone.h"
+#include "zerberus/sample.h"
+#include "zerberus/stream.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+#include <sndfile.h>
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSfzStreaming
+//    a streamed instrument must sound exactly like the
+//    same instrument held in memory
+//---------------------------------------------------------
+
+class TestSfzStreaming : public QObject, public MTest
+      {
+      Q_OBJECT
+      float samplerate = 44100;
+
+      Zerberus* createSynth(const QString& sfz);
+      void render(Zerberus*, float* out, bool wait);
+
+   private slots:
+      void initTestCase();
+      void streamedSamples();
+      void streamedAudio();
+      void missingFile();
+      };
+
+static const int SAMPLE_FRAMES = 3 * 44100;
+static const int NOTE_FRAMES   = 2 * 44100;
+static const int TOTAL_FRAMES  = NOTE_FRAMES + 44100 / 2;
+
+//---------------------------------------------------------
+//   writeFile
+//---------------------------------------------------------
+
+static void writeFile(const QString& path, const QString& text)
+      {
+      QFile f(path);
+      QVERIFY(f.open(QIODevice::WriteOnly));
+      f.write(text.toUtf8());
+      }
+
+//---------------------------------------------------------
+//   initTestCase
+//    create a sample longer than the streaming head and
+//    two instruments using it
+//---------------------------------------------------------
+
+void TestSfzStreaming::initTestCase()
+      {
+      initMTest();
+      QString dir = QDir::currentPath();
+      Ms::preferences.mySoundfontsPath += ";" + dir;
+
+      SF_INFO info;
+      memset(&info, 0, sizeof(info));
+      info.samplerate = 44100;
+      info.channels   = 1;
+      info.format     = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+      SNDFILE* sf = sf_open(qPrintable(dir + "/streamingTest.wav"), SFM_WRITE, &info);
+      QVERIFY(sf);
+      QVector<short> data(SAMPLE_FRAMES);
+      for (int i = 0; i < SAMPLE_FRAMES; ++i)
+            data[i] = short(sin(i * 0.05) * 8000.0) + (i * 7919) % 2000 - 1000;
+      QCOMPARE(int(sf_writef_short(sf, data.data(), SAMPLE_FRAMES)), SAMPLE_FRAMES);
+      sf_close(sf);
+
+      QString sfz = "<region> lokey=0 hikey=127 pitch_keycenter=60 sample=streamingTest.wav ampeg_release=0.1\n";
+      writeFile(dir + "/streamingFull.sfz", sfz);
+      writeFile(dir + "/streamingHead.sfz", sfz);
+      }
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+Zerberus* TestSfzStreaming::createSynth(const QString& sfz)
+      {
+      Zerberus* synth = new Zerberus();
+      synth->init(samplerate);
+      synth->loadInstrument(sfz);
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      return synth;
+      }
+
+//---------------------------------------------------------
+//   render
+//    play notes at, below and above the key center; with
+//    wait set every block waits until the streamer has read
+//    the frames the voices need next
+//---------------------------------------------------------
+
+void TestSfzStreaming::render(Zerberus* synth, float* out, bool wait)
+      {
+      static const int keys[] = { 55, 60, 64 };
+      for (int key : keys)
+            synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, 100));
+      for (int frame = 0; frame < TOTAL_FRAMES; frame += 256) {
+            if (frame == NOTE_FRAMES) {
+                  for (int key : keys)
+                        synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, 0));
+                  }
+            if (wait) {
+                  QElapsedTimer timer;
+                  timer.start();
+                  while (!synth->streamReady(STREAM_CHUNK)) {
+                        if (timer.elapsed() > 10000)
+                              QFAIL("streamer does not read");
+                        QThread::yieldCurrentThread();
+                        }
+                  }
+            synth->process(qMin(256, TOTAL_FRAMES - frame), out + frame * 2, nullptr, nullptr);
+            }
+      }
+
+//---------------------------------------------------------
+//   streamedSamples
+//---------------------------------------------------------
+
+void TestSfzStreaming::streamedSamples()
+      {
+      Ms::preferences.zerberusStreaming = true;
+      Zerberus* synth = createSynth("streamingHead.sfz");
+      Ms::preferences.zerberusStreaming = false;
+      QVERIFY(synth->instrument(0)->streamed());
+      Sample* s = synth->instrument(0)->zones().front()->sample;
+      QVERIFY(s->streamed());
+      QCOMPARE(s->frames(), SAMPLE_FRAMES);
+      QCOMPARE(s->headFrames(), STREAM_HEAD_FRAMES);
+      delete synth;
+
+      synth = createSynth("streamingFull.sfz");
+      QVERIFY(!synth->instrument(0)->streamed());
+      QVERIFY(!synth->instrument(0)->zones().front()->sample->streamed());
+      delete synth;
+      }
+
+//---------------------------------------------------------
+//   streamedAudio
+//---------------------------------------------------------
+
+void TestSfzStreaming::streamedAudio()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      Zerberus* synth = createSynth("streamingFull.sfz");
+      render(synth, out1.data(), false);
+      delete synth;
+
+      Ms::preferences.zerberusStreaming = true;
+      synth = createSynth("streamingHead.sfz");
+      Ms::preferences.zerberusStreaming = false;
+      QVERIFY(synth->instrument(0)->streamed());
+      render(synth, out2.data(), true);
+      QCOMPARE(synth->streamUnderruns(), 0);
+      QCOMPARE(synth->streamErrors(), 0);
+      delete synth;
+
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            if (out1[i] != out2[i])
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      }
+
+//---------------------------------------------------------
+//   missingFile
+//    a sample file removed after loading the instrument is
+//    reported, the voices play the head of the sample
+//---------------------------------------------------------
+
+void TestSfzStreaming::missingFile()
+      {
+      QString dir = QDir::currentPath();
+      QFile::remove(dir + "/streamingMissing.wav");
+      QVERIFY(QFile::copy(dir + "/streamingTest.wav", dir + "/streamingMissing.wav"));
+      writeFile(dir + "/streamingMissing.sfz", "<region> lokey=0 hikey=127 pitch_keycenter=60 sample=streamingMissing.wav\n");
+
+      Ms::preferences.zerberusStreaming = true;
+      Zerberus* synth = createSynth("streamingMissing.sfz");
+      Ms::preferences.zerberusStreaming = false;
+      QVERIFY(synth->instrument(0)->streamed());
+      QVERIFY(QFile::remove(dir + "/streamingMissing.wav"));
+
+      QVector<float> out(TOTAL_FRAMES * 2);
+      render(synth, out.data(), true);
+      QCOMPARE(synth->streamErrors(), 3);
+      delete synth;
+      }
+
+QTEST_MAIN(TestSfzStreaming)
+
+#include "tst_sfzstreaming.moc"
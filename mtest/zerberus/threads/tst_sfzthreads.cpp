@@ -0,0 +1,174 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "synthesizer/msynthesizer.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSfzThreads
+//    the voices of a MasterSynthesizer rendered by
+//    several threads
+//---------------------------------------------------------
+
+class TestSfzThreads : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      MasterSynthesizer* createSynth(int threads);
+      void render(MasterSynthesizer*, float* out);
+
+   private slots:
+      void initTestCase();
+      void deterministic();
+      void sameAsSerial();
+      void moreThreadsThanCores();
+      };
+
+static const int CHORDS       = 16;
+static const int CHORD_FRAMES = 44100 / 8;
+static const int HOLD_FRAMES  = 44100 / 2;
+static const int TOTAL_FRAMES = CHORDS * CHORD_FRAMES + HOLD_FRAMES + 44100 / 2;
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzThreads::initTestCase()
+      {
+      initMTest();
+      Ms::preferences.mySoundfontsPath += ";" + root;
+      }
+
+//---------------------------------------------------------
+//   createSynth
+//---------------------------------------------------------
+
+MasterSynthesizer* TestSfzThreads::createSynth(int threads)
+      {
+      MasterSynthesizer* ms = new MasterSynthesizer();
+      Zerberus* synth = new Zerberus();
+      ms->registerSynthesizer(synth);
+      ms->setSampleRate(44100);
+      ms->setThreads(threads);
+      synth->loadInstrument("threadsTest.sfz");
+      synth->setActive();
+      synth->play(Ms::PlayEvent(ME_PROGRAM, 0, 0, 0));
+      return ms;
+      }
+
+//---------------------------------------------------------
+//   render
+//    overlapping chords of eight notes in buffers of 64
+//    frames
+//---------------------------------------------------------
+
+void TestSfzThreads::render(MasterSynthesizer* ms, float* out)
+      {
+      static const int chord[] = { 36, 43, 48, 52, 55, 60, 64, 67 };
+      Synthesizer* synth = ms->synthesizer("Zerberus");
+      for (int frame = 0; frame < TOTAL_FRAMES; frame += 64) {
+            if (frame % CHORD_FRAMES < 64) {
+                  int n   = frame / CHORD_FRAMES;
+                  int off = n - HOLD_FRAMES / CHORD_FRAMES;
+                  if (off >= 0 && off < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + off % 12, 0));
+                        }
+                  if (n < CHORDS) {
+                        for (int key : chord)
+                              synth->play(Ms::PlayEvent(ME_NOTEON, 0, key + n % 12, 100));
+                        }
+                  }
+            ms->process(qMin(64, TOTAL_FRAMES - frame), out + frame * 2);
+            }
+      }
+
+//---------------------------------------------------------
+//   deterministic
+//    the result must not depend on which thread renders
+//    which partition
+//---------------------------------------------------------
+
+void TestSfzThreads::deterministic()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      MasterSynthesizer* ms = createSynth(3);
+      render(ms, out1.data());
+      delete ms;
+      ms = createSynth(3);
+      render(ms, out2.data());
+      delete ms;
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            if (out1[i] != out2[i])
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      }
+
+//---------------------------------------------------------
+//   sameAsSerial
+//    only the order of summation differs from the
+//    rendering on one thread
+//---------------------------------------------------------
+
+void TestSfzThreads::sameAsSerial()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      MasterSynthesizer* ms = createSynth(0);
+      render(ms, out1.data());
+      delete ms;
+      ms = createSynth(3);
+      render(ms, out2.data());
+      delete ms;
+      float peak = 0.0;
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            peak = qMax(peak, qAbs(out1[i]));
+            if (qAbs(out1[i] - out2[i]) > 1e-4)
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      QVERIFY(peak > 0.0);
+      }
+
+//---------------------------------------------------------
+//   moreThreadsThanCores
+//    workers are preempted while they render a partition;
+//    the audio thread has to wait for them and must still
+//    get the complete result
+//---------------------------------------------------------
+
+void TestSfzThreads::moreThreadsThanCores()
+      {
+      QVector<float> out1(TOTAL_FRAMES * 2);
+      QVector<float> out2(TOTAL_FRAMES * 2);
+      MasterSynthesizer* ms = createSynth(0);
+      render(ms, out1.data());
+      delete ms;
+      ms = createSynth(qMax(QThread::idealThreadCount(), 2) * 2);
+      render(ms, out2.data());
+      delete ms;
+      for (int i = 0; i < TOTAL_FRAMES * 2; ++i) {
+            if (qAbs(out1[i] - out2[i]) > 1e-4)
+                  QFAIL(qPrintable(QString("sample %1 differs: %2 %3").arg(i).arg(out1[i]).arg(out2[i])));
+            }
+      }
+
+QTEST_MAIN(TestSfzThreads)
+
+#include "tst_sfzthreads.moc"
@@ -22,6 +22,61 @@ namespace Ms {
 
 extern QString dataPath;
 
+static const int WORKER_SPIN = 2000;      // yields before an idle worker parks
+
+//---------------------------------------------------------
+//   SynthesizerWorker
+//    helps the audio thread to render partitions.
+//    Partitions not taken in time are rendered by the
+//    audio thread itself; the audio thread only waits for
+//    the partitions a worker has already started.
+//    A worker without work parks on a semaphore, so no
+//    cpu is used while the transport is stopped.
+//---------------------------------------------------------
+
+class SynthesizerWorker : public QThread {
+      MasterSynthesizer* _ms;
+
+   protected:
+      virtual void run();
+
+   public:
+      std::atomic<bool> quit { false };
+      SynthesizerWorker(MasterSynthesizer* ms) : _ms(ms) {}
+      };
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SynthesizerWorker::run()
+      {
+      unsigned job = _ms->_job.load();
+      int idle     = 0;
+      while (!quit.load()) {
+            unsigned j = _ms->_job.load();
+            if (j != job) {
+                  job  = j;
+                  idle = 0;
+                  int n = _ms->renderPartitions();
+                  if (n)
+                        _ms->_done.release(n);
+                  }
+            else if (++idle < WORKER_SPIN)
+                  QThread::yieldCurrentThread();
+            else {
+                  // processPartitions() publishes the job before it
+                  // looks at _parked, so either the new job is seen
+                  // here or the worker is woken; a wakeup not needed
+                  // only costs another round of spinning
+                  _ms->_parked.fetch_add(1);
+                  if (_ms->_job.load() == job && !quit.load())
+                        _ms->_wake.acquire();
+                  idle = 0;
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   default buildin SynthesizerState
 //    used if synthesizer.xml does not exist or is not
@@ -84,6 +139,7 @@ void MasterSynthesizer::init()
 
 MasterSynthesizer::~MasterSynthesizer()
       {
+      setThreads(0);
       for (Synthesizer* s : _synthesizer)
             delete s;
       for (int i = 0; i < MAX_EFFECTS; ++i) {
@@ -197,6 +253,7 @@ Synthesizer* MasterSynthesizer::synthesizer(const QString& name)
 void MasterSynthesizer::registerSynthesizer(Synthesizer* s)
       {
       _synthesizer.push_back(s);
+      _partitioned.reserve(_synthesizer.size());
       }
 
 //---------------------------------------------------------
@@ -253,6 +310,112 @@ void MasterSynthesizer::setSampleRate(float val)
       lock1 = false;
       }
 
+//---------------------------------------------------------
+//   setThreads
+//    set the number of threads helping the audio thread;
+//    must not be called while the audio is running
+//---------------------------------------------------------
+
+void MasterSynthesizer::setThreads(int n)
+      {
+      for (SynthesizerWorker* w : _workers)
+            w->quit = true;
+      _wake.release(int(_workers.size()));
+      for (SynthesizerWorker* w : _workers) {
+            w->wait();
+            delete w;
+            }
+      _workers.clear();
+      _wake.tryAcquire(_wake.available());
+      _parked = 0;
+      for (int i = 0; i < n; ++i)
+            _workers.push_back(new SynthesizerWorker(this));
+      _partitionBuffer.assign(n ? partitions() * 3 * MAX_BUFFERSIZE : 0, 0.0f);
+      _partitioned.reserve(_synthesizer.size());
+      _nextPartition = partitions();
+      for (SynthesizerWorker* w : _workers)
+            w->start(QThread::TimeCriticalPriority);
+      }
+
+//---------------------------------------------------------
+//   renderPartitions
+//    called by the audio thread and the workers; render
+//    partitions until there are none left and return the
+//    number of partitions rendered
+//---------------------------------------------------------
+
+int MasterSynthesizer::renderPartitions()
+      {
+      int parts    = partitions();
+      int rendered = 0;
+      for (;;) {
+            int part = _nextPartition.fetch_add(1, std::memory_order_acq_rel);
+            if (part >= parts)
+                  break;
+            unsigned n = _partitionFrames;
+            float* out = partitionBuffer(part, 0);
+            float* e1  = partitionBuffer(part, 1);
+            float* e2  = partitionBuffer(part, 2);
+            memset(out, 0, n * sizeof(float) * 2);
+            memset(e1, 0, n * sizeof(float) * 2);
+            memset(e2, 0, n * sizeof(float) * 2);
+            for (Synthesizer* s : _partitioned)
+                  s->processPartition(part, parts, n, out, e1, e2);
+            ++rendered;
+            }
+      return rendered;
+      }
+
+//---------------------------------------------------------
+//   processPartitions
+//    The voices of the synthesizers are split into one
+//    partition per thread. Every partition is rendered
+//    into its own buffer; the buffers are summed in a
+//    fixed order, so the result does not depend on which
+//    thread rendered which partition.
+//---------------------------------------------------------
+
+void MasterSynthesizer::processPartitions(unsigned n, float* p)
+      {
+      _partitioned.clear();
+      for (Synthesizer* s : _synthesizer) {
+            if (!s->active())
+                  continue;
+            if (s->beginPartitions())
+                  _partitioned.push_back(s);
+            else
+                  s->process(n, p, effect1Buffer, effect2Buffer);
+            }
+      if (_partitioned.empty())
+            return;
+
+      int parts        = partitions();
+      _partitionFrames = n;
+      _nextPartition.store(0);
+      _job.fetch_add(1);
+      int parked = _parked.exchange(0);
+      if (parked)
+            _wake.release(parked);
+      // a partition being rendered by a worker cannot be taken
+      // back; block until the workers have finished theirs
+      int pending = parts - renderPartitions();
+      if (pending)
+            _done.acquire(pending);
+
+      for (int part = 0; part < parts; ++part) {
+            const float* out = partitionBuffer(part, 0);
+            const float* e1  = partitionBuffer(part, 1);
+            const float* e2  = partitionBuffer(part, 2);
+            for (unsigned i = 0; i < n * 2; ++i) {
+                  p[i]             += out[i];
+                  effect1Buffer[i] += e1[i];
+                  effect2Buffer[i] += e2[i];
+                  }
+            }
+      for (Synthesizer* s : _partitioned)
+            s->endPartitions();
+      }
+
 //---------------------------------------------------------
 //   process
 //---------------------------------------------------------
@@ -269,10 +432,14 @@ void MasterSynthesizer::process(unsigned n, float* p)
       // avoid overflow
       if (n > MAX_BUFFERSIZE / 2)
             return;
-      for (Synthesizer* s : _synthesizer) {
-            if (s->active())
-                  s->process(n, p, effect1Buffer, effect2Buffer);
+      if (_workers.empty()) {
+            for (Synthesizer* s : _synthesizer) {
+                  if (s->active())
+                        s->process(n, p, effect1Buffer, effect2Buffer);
+                  }
             }
+      else
+            processPartitions(n, p);
 
       if (_effect[0] && _effect[1]) {
             memset(effect1Buffer, 0, n * sizeof(float) * 2);
@@ -292,6 +459,39 @@ void MasterSynthesizer::process(unsigned n, float* p)
       lock1 = false;
       }
 
+//---------------------------------------------------------
+//   processChannels
+//    render every MIDI channel to its own stereo bus;
+//    effects and gain are not applied. Used to export
+//    one audio file per part.
+//---------------------------------------------------------
+
+bool MasterSynthesizer::processChannels(unsigned n, float** bus, int channels)
+      {
+      if (lock2)
+            return false;
+      lock1 = true;
+      if (lock2) {
+            lock1 = false;
+            return false;
+            }
+      bool rv = n <= MAX_BUFFERSIZE / 2;
+      if (rv) {
+            // the effect sends of the voices are not used here,
+            // but must not accumulate from block to block
+            memset(effect1Buffer, 0, n * sizeof(float) * 2);
+            memset(effect2Buffer, 0, n * sizeof(float) * 2);
+            for (Synthesizer* s : _synthesizer) {
+                  if (s->active() && !s->processChannels(n, bus, channels, effect1Buffer, effect2Buffer)) {
+                        qDebug("MasterSynthesizer: %s did not render the channels separately", s->name());
+                        rv = false;
+                        }
+                  }
+            }
+      lock1 = false;
+      return rv;
+      }
+
 //---------------------------------------------------------
 //   indexOfEffect
 //---------------------------------------------------------
@@ -14,6 +14,7 @@
 #define __MSYNTHESIZER_H__
 
 #include <atomic>
+#include <QSemaphore>
 #include "effects/effect.h"
 #include "libmscore/synthesizerstate.h"
 
@@ -24,6 +25,7 @@ class NPlayEvent;
 class Synthesizer;
 class Effect;
 class Xml;
+class SynthesizerWorker;
 
 //---------------------------------------------------------
 //   MasterSynthesizer
@@ -54,6 +56,24 @@ class MasterSynthesizer : public QObject {
       float effect2Buffer[MAX_BUFFERSIZE];
       int indexOfEffect(int ab, const QString& name);
 
+      // rendering in partitions, see process()
+      std::vector<SynthesizerWorker*> _workers;
+      std::vector<Synthesizer*> _partitioned;   // synthesizers of the current job
+      std::vector<float> _partitionBuffer;      // output and effect sends of every partition
+      unsigned _partitionFrames { 0 };
+      std::atomic<unsigned> _job       { 0 };
+      std::atomic<int> _nextPartition  { 0 };
+      std::atomic<int> _parked         { 0 };   // workers waiting on _wake
+      QSemaphore _wake;                         // wakes parked workers for a new job
+      QSemaphore _done;                         // one token per partition a worker rendered
+
+      int partitions() const { return int(_workers.size()) + 1; }
+      float* partitionBuffer(int part, int buffer) { return &_partitionBuffer[(part * 3 + buffer) * MAX_BUFFERSIZE]; }
+      void processPartitions(unsigned, float*);
+      int renderPartitions();
+
+      friend class SynthesizerWorker;
+
    public slots:
       void sfChanged() { emit soundFontChanged(); }
       void setGain(float f);
@@ -73,6 +93,9 @@ class MasterSynthesizer : public QObject {
       void setSampleRate(float val);
 
       void process(unsigned, float*);
+      bool processChannels(unsigned, float** bus, int channels);
+      void setThreads(int);
+      int threads() const           { return int(_workers.size()); }
       void play(const NPlayEvent&, unsigned);
 
       void setMasterTuning(double val);
@@ -51,6 +51,19 @@ class Synthesizer {
       virtual QStringList soundFonts() const = 0;
 
       virtual void process(unsigned, float*, float*, float*) = 0;
+
+      // Rendering in partitions, see MasterSynthesizer::process().
+      // If beginPartitions() returns true, processPartition() is
+      // called once for every partition, possibly from several
+      // threads at the same time, followed by endPartitions().
+      virtual bool beginPartitions()                                       { return false; }
+      virtual void processPartition(int, int, unsigned, float*, float*, float*) {}
+      virtual void endPartitions()                                         {}
+
+      // Multitrack rendering: the voices of MIDI channel c are added
+      // to bus[c]. Returns false if the synthesizer cannot render
+      // its channels separately or could not render this block.
+      virtual bool processChannels(unsigned, float**, int, float*, float*) { return false; }
       virtual void play(const PlayEvent&) = 0;
 
       virtual const QList<MidiPatch*>& getPatchInfo() const = 0;
@@ -17,12 +17,14 @@
 #include <QStringList>
 
 #include "libmscore/xml.h"
+#include "mscore/preferences.h"
 #include "audiofile/audiofile.h"
 #include "thirdparty/qzip/qzipreader_p.h"
 
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
+#include "stream.h"
 
 QByteArray ZInstrument::buf;
 int ZInstrument::idx;
@@ -36,12 +38,60 @@ Sample::~Sample()
       delete[] _data;
       }
 
+//---------------------------------------------------------
+//   readSampleHead
+//    read only the first STREAM_HEAD_FRAMES frames of a
+//    sample, return 0 if the sample is too short to be
+//    streamed or has a loop
+//---------------------------------------------------------
+
+static Sample* readSampleHead(const QString& s)
+      {
+      AudioFile a;
+      if (!a.open(s))
+            return 0;
+
+      int channel = a.channels();
+      int frames  = a.frames();
+      int sr      = a.samplerate();
+      if (channel > 2 || frames < STREAM_HEAD_FRAMES * 2 || int(a.loopEnd()) > 0)
+            return 0;
+
+      short* data = new short[(STREAM_HEAD_FRAMES + 3) * channel];
+      Sample* sa  = new Sample(channel, data, frames, sr);
+      sa->setLoopStart(a.loopStart());
+      sa->setLoopEnd(a.loopEnd());
+      sa->setLoopMode(a.loopMode());
+
+      if (STREAM_HEAD_FRAMES != a.read(data + channel, STREAM_HEAD_FRAMES)) {
+            qDebug("Sample read failed: %s\n", a.error());
+            delete sa;
+            return 0;
+            }
+      for (int i = 0; i < channel; ++i) {
+            data[i] = data[channel + i];
+            data[(STREAM_HEAD_FRAMES + 1) * channel + i] = 0;
+            data[(STREAM_HEAD_FRAMES + 2) * channel + i] = 0;
+            }
+      sa->setStream(s, STREAM_HEAD_FRAMES);
+      return sa;
+      }
+
 //---------------------------------------------------------
 //   readSample
+//    if stream is set and streaming is enabled, only the
+//    head of a long sample file is loaded
 //---------------------------------------------------------
 
-Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
+Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz, bool stream)
       {
+      if (stream && !uz && Ms::preferences.zerberusStreaming) {
+            Sample* sa = readSampleHead(s);
+            if (sa) {
+                  _streamed = true;
+                  return sa;
+                  }
+            }
       if (uz) {
             QList<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -100,6 +150,7 @@ ZInstrument::ZInstrument(Zerberus* z)
             _setcc[i] = -1;
       _program  = -1;
       _refCount = 0;
+      _streamed = false;
       }
 
 //---------------------------------------------------------
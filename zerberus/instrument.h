@@ -35,6 +35,7 @@ class ZInstrument {
       QString instrumentPath;
       std::list<Zone*> _zones;
       int _setcc[128];
+      bool _streamed;
 
       bool loadFromFile(const QString&);
       bool loadSfz(const QString&);
@@ -53,7 +54,8 @@ class ZInstrument {
       QString path() const                  { return instrumentPath; }
       const std::list<Zone*>& zones() const { return _zones;  }
       std::list<Zone*>& zones()             { return _zones;  }
-      Sample* readSample(const QString& s, MQZipReader* uz);
+      Sample* readSample(const QString& s, MQZipReader* uz, bool stream = false);
+      bool streamed() const                 { return _streamed; }
       void addZone(Zone* z)                 { _zones.push_back(z); }
       void addRegion(SfzRegion&);
       int getSetCC(int v)                   { return _setcc[v]; }
@@ -15,6 +15,9 @@
 
 //---------------------------------------------------------
 //   Sample
+//    A streamed sample holds only the first headFrames()
+//    frames in memory, the rest is read from path() while
+//    playing.
 //---------------------------------------------------------
 
 class Sample {
@@ -25,16 +28,22 @@ class Sample {
       int _loopStart;
       int _loopEnd;
       int _loopMode;
+      int _headFrames;
+      QString _path;
 
    public:
       Sample(int ch, short* val, int f, int sr)
-         : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+         : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _headFrames(f) {}
       ~Sample();
       bool read(const QString&);
       int frames() const     { return _frames;          }
       short* data() const    { return _data + _channel; }
       int channel() const    { return _channel;         }
       int sampleRate() const { return _sampleRate;      }
+      int headFrames() const { return _headFrames;      }
+      bool streamed() const  { return _headFrames < _frames; }
+      const QString& path() const { return _path;      }
+      void setStream(const QString& path, int headFrames) { _path = path; _headFrames = headFrames; }
 
       void setLoopStart (int v) { _loopStart = v; }
       void setLoopEnd (int v)   { _loopEnd = v; }
@@ -264,7 +264,9 @@ void ZInstrument::addRegion(SfzRegion& r)
                   }
             }
       Zone* z = new Zone;
-      z->sample = readSample(r.sample, 0);
+      // a sample with a loop range has to be held in memory completely
+      bool loop = r.loopEnd > 0 && (r.loop_mode == LoopMode::CONTINUOUS || r.loop_mode == LoopMode::SUSTAIN);
+      z->sample = readSample(r.sample, 0, !loop);
       if (z->sample) {
             qDebug("Sample Loop - start %d, end %d, mode %d", z->sample->loopStart(), z->sample->loopEnd(), z->sample->loopMode());
             // if there is no opcode defining loop ranges, use sample definitions as fallback (according to spec)
@@ -0,0 +1,345 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <string.h>
+#include <sndfile.h>
+
+#include "stream.h"
+#include "sample.h"
+
+//---------------------------------------------------------
+//   StreamBuffer
+//---------------------------------------------------------
+
+StreamBuffer::StreamBuffer()
+      {
+      _ring      = new short[STREAM_RING_FRAMES * 2];
+      _state     = 0;
+      _active    = false;
+      _readFrame = 0;
+      _underruns = 0;
+      _errors    = 0;
+      _failedGen = -1;
+      _sample    = 0;
+      _offset    = 0;
+      _first     = 0;
+      _end       = 0;
+      _channels  = 1;
+      }
+
+StreamBuffer::~StreamBuffer()
+      {
+      delete[] _ring;
+      }
+
+//---------------------------------------------------------
+//   start
+//    called by the voice; frames before first are played
+//    from the head of the sample
+//---------------------------------------------------------
+
+void StreamBuffer::start(const Sample* s, int offset, int first)
+      {
+      _sample.store(s, std::memory_order_relaxed);
+      _offset.store(offset, std::memory_order_relaxed);
+      _first.store(first, std::memory_order_relaxed);
+      _end.store(s->frames() - offset, std::memory_order_relaxed);
+      _channels.store(s->channel(), std::memory_order_relaxed);
+      _readFrame.store(first, std::memory_order_relaxed);
+      int64_t gen = (_state.load(std::memory_order_relaxed) >> 32) + 1;
+      _state.store((gen << 32) | uint32_t(first), std::memory_order_release);
+      _active.store(true, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   stop
+//---------------------------------------------------------
+
+void StreamBuffer::stop()
+      {
+      _active.store(false, std::memory_order_release);
+      int64_t gen = (_state.load(std::memory_order_relaxed) >> 32) + 1;
+      _state.store(gen << 32, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   failed
+//    the streamer gave up reading the sample of the
+//    current voice
+//---------------------------------------------------------
+
+bool StreamBuffer::failed() const
+      {
+      return _failedGen.load(std::memory_order_acquire) == (_state.load(std::memory_order_acquire) >> 32);
+      }
+
+//---------------------------------------------------------
+//   ready
+//    the next frames after the read position are in the
+//    ring or the stream cannot deliver more
+//---------------------------------------------------------
+
+bool StreamBuffer::ready(int frames) const
+      {
+      if (!_active.load(std::memory_order_acquire) || failed())
+            return true;
+      int end = qMin(_readFrame.load(std::memory_order_acquire) + frames, _end.load(std::memory_order_relaxed));
+      return writeFrame() >= end;
+      }
+
+//---------------------------------------------------------
+//   data
+//    pos is a sample index as in Voice::getData();
+//    frames not yet read are returned as silence
+//---------------------------------------------------------
+
+short StreamBuffer::data(int pos, int channels) const
+      {
+      if (pos / channels >= writeFrame())
+            return 0;
+      return _ring[pos & (STREAM_RING_FRAMES * channels - 1)];
+      }
+
+//---------------------------------------------------------
+//   Reader
+//    the file a stream is read from, only used by the
+//    streamer thread
+//---------------------------------------------------------
+
+struct SampleStreamer::Reader {
+      int64_t gen   { -1 };
+      SNDFILE* sf   { 0 };
+      const Sample* sample { 0 };
+      int offset    { 0 };
+      int retries   { 0 };      // failed attempts to open the file, -1: given up
+      int first     { 0 };
+      int frame     { 0 };
+      int end       { 0 };
+      int channels  { 1 };
+
+      void close() {
+            if (sf)
+                  sf_close(sf);
+            sf  = 0;
+            gen = -1;
+            }
+      };
+
+//---------------------------------------------------------
+//   SampleStreamer
+//---------------------------------------------------------
+
+SampleStreamer::SampleStreamer()
+      {
+      _quit = false;
+      }
+
+SampleStreamer::~SampleStreamer()
+      {
+      _quit = true;
+      _mutex.lock();
+      _wake.wakeAll();
+      _mutex.unlock();
+      wait();
+      for (StreamBuffer* sb : _streams)
+            delete sb;
+      for (Reader* r : _readers)
+            delete r;
+      }
+
+//---------------------------------------------------------
+//   addStream
+//    streams can only be added before the thread is
+//    started
+//---------------------------------------------------------
+
+StreamBuffer* SampleStreamer::addStream()
+      {
+      Q_ASSERT(!isRunning());
+      StreamBuffer* sb = new StreamBuffer;
+      _streams.push_back(sb);
+      _readers.push_back(new Reader);
+      return sb;
+      }
+
+//---------------------------------------------------------
+//   underruns
+//    number of frames rendered as silence because the
+//    data were not read in time
+//---------------------------------------------------------
+
+int SampleStreamer::underruns() const
+      {
+      int n = 0;
+      for (const StreamBuffer* sb : _streams)
+            n += sb->underruns();
+      return n;
+      }
+
+void SampleStreamer::resetUnderruns()
+      {
+      for (StreamBuffer* sb : _streams)
+            sb->resetUnderruns();
+      }
+
+//---------------------------------------------------------
+//   errors
+//    number of streamed voices whose sample file could not
+//    be opened or read
+//---------------------------------------------------------
+
+int SampleStreamer::errors() const
+      {
+      int n = 0;
+      for (const StreamBuffer* sb : _streams)
+            n += sb->errors();
+      return n;
+      }
+
+//---------------------------------------------------------
+//   ready
+//    all streams have the next frames in their ring
+//---------------------------------------------------------
+
+bool SampleStreamer::ready(int frames) const
+      {
+      for (const StreamBuffer* sb : _streams) {
+            if (!sb->ready(frames))
+                  return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SampleStreamer::run()
+      {
+      while (!_quit) {
+            bool busy = false;
+            for (size_t i = 0; i < _streams.size(); ++i)
+                  busy |= fill(_streams[i], _readers[i]);
+            if (!busy) {
+                  // all rings are full or idle, wait for the voices
+                  // to consume some data
+                  _mutex.lock();
+                  if (!_quit)
+                        _wake.wait(&_mutex, 2);
+                  _mutex.unlock();
+                  }
+            }
+      for (Reader* r : _readers)
+            r->close();
+      }
+
+//---------------------------------------------------------
+//   fill
+//    read the next chunk of a stream, return false if there
+//    was nothing to do
+//---------------------------------------------------------
+
+bool SampleStreamer::fill(StreamBuffer* sb, Reader* r)
+      {
+      int64_t state = sb->_state.load(std::memory_order_acquire);
+      if (!sb->_active.load(std::memory_order_acquire)) {
+            r->close();
+            return false;
+            }
+      int64_t gen = state >> 32;
+      if (gen != r->gen) {
+            // the voice was (re)started
+            r->close();
+            const Sample* s = sb->_sample.load(std::memory_order_relaxed);
+            int offset      = sb->_offset.load(std::memory_order_relaxed);
+            r->first        = sb->_first.load(std::memory_order_relaxed);
+            r->end          = sb->_end.load(std::memory_order_relaxed);
+            r->channels     = sb->_channels.load(std::memory_order_relaxed);
+            if ((sb->_state.load(std::memory_order_acquire) >> 32) != gen)
+                  return true;      // restarted again while reading the parameters
+            r->gen     = gen;
+            r->sample  = s;
+            r->offset  = offset;
+            r->retries = 0;
+            r->frame   = r->first;
+            }
+      if (!r->sf && !open(sb, r))
+            return false;
+      if (int(state & 0xffffffff) != r->frame)
+            return false;
+
+      // do not overwrite frames the voice may still read
+      int needed = qMax(sb->_readFrame.load(std::memory_order_acquire) - 2, r->first);
+      int n      = qMin(needed + STREAM_RING_FRAMES - r->frame, r->end - r->frame);
+      n          = qMin(n, STREAM_CHUNK);
+      int slot   = r->frame & (STREAM_RING_FRAMES - 1);
+      n          = qMin(n, STREAM_RING_FRAMES - slot);
+      if (n <= 0)
+            return false;
+
+      sf_count_t got = sf_readf_short(r->sf, sb->_ring + slot * r->channels, n);
+      if (got <= 0) {
+            fail(sb, r, sf_strerror(r->sf));
+            return false;
+            }
+      r->frame += got;
+      int64_t next = (gen << 32) | uint32_t(r->frame);
+      // fails if the voice was restarted meanwhile
+      sb->_state.compare_exchange_strong(state, next, std::memory_order_release, std::memory_order_relaxed);
+      return true;
+      }
+
+
+//---------------------------------------------------------
+//   open
+//    open the sample file of the stream and seek to the
+//    first streamed frame. A failed open is retried on the
+//    next calls, the streamer waits a few milliseconds in
+//    between.
+//---------------------------------------------------------
+
+bool SampleStreamer::open(StreamBuffer* sb, Reader* r)
+      {
+      if (r->retries < 0)
+            return false;
+      SF_INFO info;
+      memset(&info, 0, sizeof(info));
+      r->sf = sf_open(qPrintable(r->sample->path()), SFM_READ, &info);
+      if (!r->sf) {
+            if (++r->retries < STREAM_OPEN_RETRIES)
+                  return false;
+            fail(sb, r, sf_strerror(0));
+            return false;
+            }
+      if (sf_seek(r->sf, r->first + r->offset, SEEK_SET) < 0) {
+            fail(sb, r, sf_strerror(r->sf));
+            return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   fail
+//    give up streaming the current voice; it plays the
+//    rest of the sample as silence
+//---------------------------------------------------------
+
+void SampleStreamer::fail(StreamBuffer* sb, Reader* r, const char* msg)
+      {
+      qWarning("SampleStreamer: cannot read <%s>: %s", qPrintable(r->sample->path()), msg);
+      if (r->sf)
+            sf_close(r->sf);
+      r->sf      = 0;
+      r->retries = -1;
+      sb->_errors.fetch_add(1, std::memory_order_relaxed);
+      sb->_failedGen.store(r->gen, std::memory_order_release);
+      }
@@ -0,0 +1,114 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2016 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+class Sample;
+
+static const int STREAM_HEAD_FRAMES = 32768;    // frames of a streamed sample kept in memory
+static const int STREAM_RING_FRAMES = 16384;    // ring buffer size per voice, power of two
+static const int STREAM_CHUNK       = 2048;     // frames read from disk at once
+static const int STREAM_OPEN_RETRIES = 10;      // attempts to open a sample file
+
+//---------------------------------------------------------
+//   StreamBuffer
+//    Ring buffer of a voice playing a streamed sample.
+//    Positions are voice frames, i.e. sample frames
+//    relative to the zone offset. The voice reads from the
+//    audio thread, the SampleStreamer writes from its own
+//    thread. _state holds a generation count in the upper
+//    32 bits, which changes whenever the voice starts or
+//    stops, and the end of the valid data in the lower 32
+//    bits.
+//---------------------------------------------------------
+
+class StreamBuffer {
+      short* _ring;
+      std::atomic<int64_t> _state;
+      std::atomic<bool> _active;
+      std::atomic<int> _readFrame;        // first frame still needed by the voice
+      std::atomic<int> _underruns;
+      std::atomic<int> _errors;           // sample files which could not be read
+      std::atomic<int64_t> _failedGen;    // generation given up by the streamer
+
+      // set by start(), published by _state
+      std::atomic<const Sample*> _sample;
+      std::atomic<int> _offset;     // sample frame of voice frame 0
+      std::atomic<int> _first;      // first frame read from disk
+      std::atomic<int> _end;        // end of the sample in voice frames
+      std::atomic<int> _channels;
+
+      friend class SampleStreamer;
+
+   public:
+      StreamBuffer();
+      ~StreamBuffer();
+
+      void start(const Sample*, int offset, int first);
+      void stop();
+
+      int writeFrame() const       { return int(_state.load(std::memory_order_acquire) & 0xffffffff); }
+      void setReadFrame(int f)     { _readFrame.store(f, std::memory_order_release); }
+      const short* ring() const    { return _ring; }
+      short data(int pos, int channels) const;
+      void underrun()              { _underruns.fetch_add(1, std::memory_order_relaxed); }
+      int underruns() const        { return _underruns.load(std::memory_order_relaxed); }
+      void resetUnderruns()        { _underruns.store(0, std::memory_order_relaxed); }
+      int errors() const           { return _errors.load(std::memory_order_relaxed); }
+      bool failed() const;
+      bool ready(int frames) const;
+      };
+
+//---------------------------------------------------------
+//   SampleStreamer
+//    background thread which keeps the ring buffers of all
+//    voices of a Zerberus instance filled
+//---------------------------------------------------------
+
+class SampleStreamer : public QThread {
+      struct Reader;
+
+      std::vector<StreamBuffer*> _streams;
+      std::vector<Reader*> _readers;
+      std::atomic<bool> _quit;
+      QMutex _mutex;
+      QWaitCondition _wake;
+
+      bool fill(StreamBuffer*, Reader*);
+      bool open(StreamBuffer*, Reader*);
+      void fail(StreamBuffer*, Reader*, const char* msg);
+
+   protected:
+      virtual void run();
+
+   public:
+      SampleStreamer();
+      ~SampleStreamer();
+
+      StreamBuffer* addStream();
+      int underruns() const;
+      void resetUnderruns();
+      int errors() const;
+      bool ready(int frames) const;
+      };
+
+#endif
+
@@ -18,6 +18,7 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "stream.h"
 #include "synthesizer/msynthesizer.h"
 
 float Voice::interpCoeff[INTERP_MAX][4];
@@ -63,6 +64,19 @@ void Voice::stop(float time)
       currentEnvelope = V1Envelopes::RELEASE;
       }
 
+//---------------------------------------------------------
+//   off
+//---------------------------------------------------------
+
+void Voice::off()
+      {
+      _state = VoiceState::OFF;
+      if (_streaming) {
+            _stream->stop();
+            _streaming = false;
+            }
+      }
+
 //---------------------------------------------------------
 //   init
 //---------------------------------------------------------
@@ -108,6 +122,20 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
       audioChan = s->channel();
       data      = s->data() + z->offset * audioChan;
       eidx      = s->frames() * audioChan;
+      if (_streaming)
+            _stream->stop();
+      _streaming = false;
+      if (s->streamed()) {
+            if (_stream) {
+                  // frames behind the head are read into the ring buffer
+                  _streaming   = true;
+                  _streamStart = qMax(0, s->headFrames() - z->offset);
+                  _streamEnd   = s->frames() - z->offset;
+                  _stream->start(s, z->offset, _streamStart);
+                  }
+            else
+                  eidx = s->headFrames() * audioChan;
+            }
       _loopMode = z->loopMode;
       _loopStart = z->loopStart;
       _loopEnd   = z->loopEnd;
@@ -303,6 +331,11 @@ void Voice::updateEnvelopes() {
 
 //---------------------------------------------------------
 //   process
+//    The voice is rendered in blocks. A block ends at the
+//    next loop point, envelope stage change or at the end
+//    of a filter transition; within a block the sample
+//    data are read without range checks. Frames at the
+//    block boundaries are rendered one by one.
 //---------------------------------------------------------
 
 void Voice::process(int frames, float* p)
@@ -325,84 +358,154 @@ void Voice::process(int frames, float* p)
             last_fres = _fres;
             }
 
-      if (audioChan == 1) {
-            while (frames--) {
-
-                  updateLoop();
+      while (frames > 0) {
+            int n = blockFrames(frames);
+            if (n)
+                  processBlock(n, p);
+            else {
+                  n = 1;
+                  if (!processFrame(p))
+                        break;
+                  }
+            p      += n * 2;
+            frames -= n;
+            }
+      }
 
-                  int idx = phase.index();
+//---------------------------------------------------------
+//   blockFrames
+//    return the number of frames (up to frames) which can
+//    be rendered by processBlock(), 0 if the next frame
+//    has to be rendered by processFrame()
+//---------------------------------------------------------
 
-                  if (idx >= eidx) {
-                        off();
-                        break;
-                        }
-                  const float* coeffs = interpCoeff[phase.fract()];
-                  float f;
-                  f =  (coeffs[0] * getData(idx-1)
-                      + coeffs[1] * getData(idx+0)
-                      + coeffs[2] * getData(idx+1)
-                      + coeffs[3] * getData(idx+2)) * gain
-                      - a1 * hist1l
-                      - a2 * hist2l;
-                  float v = b02 * (f + hist2l) + b1 * hist1l;
-                  hist2l  = hist1l;
-                  hist1l  = f;
+int Voice::blockFrames(int frames) const
+      {
+      if (filter_coeff_incr_count || phaseIncr.data <= 0)
+            return 0;
+      int n = qMin(frames, BLOCK_FRAMES);
 
-                  if (filter_coeff_incr_count) {
-                        --filter_coeff_incr_count;
-                        a1  += a1_incr;
-                        a2  += a2_incr;
-                        b02 += b02_incr;
-                        b1  += b1_incr;
-                        }
+      // no envelope stage change within the block
+      if (_state == VoiceState::ATTACK || _state == VoiceState::STOP)
+            n = qMin(n, envelopes[currentEnvelope].count);
+      else if (_state != VoiceState::PLAYING && _state != VoiceState::SUSTAINED)
+            return 0;
+      if (n <= 0)
+            return 0;
 
-                  updateEnvelopes();
-                  if (_state == VoiceState::OFF)
-                        break;
-                  v *= envelopes[currentEnvelope].val * z->ccGain;
+      // all interpolation points inside the sample data and
+      // no loop point within the block
+      int firstIdx = 1;
+      int lastIdx  = eidx / audioChan - 1;
+      if (loopActive()) {
+            if (_looping)
+                  firstIdx = _loopStart + 1;
+            lastIdx = qMin(lastIdx, _loopEnd - (audioChan * 3 - 1));
+            }
+      int idx = phase.index();
 
-                  *p++  += v * _channel->panLeftGain();
-                  *p++  += v * _channel->panRightGain();
-                  phase += phaseIncr;
-                  _samplesSinceStart++;
+      // either all points in the sample head or all in the
+      // part of the ring buffer which is read and does not wrap
+      if (_streaming) {
+            if (idx + 2 < _streamStart)
+                  lastIdx = qMin(lastIdx, _streamStart - 3);
+            else if (idx - 1 >= _streamStart) {
+                  lastIdx = qMin(lastIdx, _stream->writeFrame() - 3);
+                  lastIdx = qMin(lastIdx, ((idx - 1) | (STREAM_RING_FRAMES - 1)) - 2);
                   }
+            else
+                  return 0;
             }
-      else {
-            //
-            // handle interleaved stereo samples
-            //
-            while (frames--) {
-
-                  updateLoop();
-
-                  int idx = phase.index() * 2;
-                  if (idx >= eidx) {
-                        off();
-                        // printf("end of sample\n");
-                        break;
-                        }
-
-                  const float* coeffs = interpCoeff[phase.fract()];
-                  float f1, f2;
+      if (idx < firstIdx || idx > lastIdx)
+            return 0;
+      int64_t room = (int64_t(lastIdx + 1) << 8) - 1 - phase.data;
+      return int(qMin(int64_t(n), room / phaseIncr.data + 1));
+      }
 
-                  f1 = (coeffs[0] * getData(idx-2)
-                      + coeffs[1] * getData(idx)
-                      + coeffs[2] * getData(idx+2)
-                      + coeffs[3] * getData(idx+4))
-                      * gain * _channel->panLeftGain() * z->ccGain;
+//---------------------------------------------------------
+//   processBlock
+//    render n frames as computed by blockFrames()
+//---------------------------------------------------------
 
-                  f2 = (coeffs[0] * getData(idx-1)
-                      + coeffs[1] * getData(idx+1)
-                      + coeffs[2] * getData(idx+3)
-                      + coeffs[3] * getData(idx+5))
-                      * gain * _channel->panRightGain() * z->ccGain;
+void Voice::processBlock(int n, float* p)
+      {
+      float in1[BLOCK_FRAMES];
+      float in2[BLOCK_FRAMES];
+      float env[BLOCK_FRAMES];
+
+      updateLoop();     // set _looping only, there is no loop point in this block
+
+      // interpolate the sample data
+      const int64_t pos  = phase.data;
+      const int64_t incr = phaseIncr.data;
+      const short* src   = data;
+      int64_t base       = 0;
+      if (_streaming && phase.index() > _streamStart) {
+            src  = _stream->ring();
+            base = int64_t((phase.index() - 1) & ~(STREAM_RING_FRAMES - 1)) << 8;
+            }
+      if (audioChan == 1) {
+            for (int i = 0; i < n; ++i) {
+                  int64_t ph          = pos + i * incr;
+                  const short* d      = src + ((ph - base) >> 8);
+                  const float* coeffs = interpCoeff[ph & 0xff];
+                  in1[i] = (coeffs[0] * d[-1]
+                         + coeffs[1] * d[0]
+                         + coeffs[2] * d[1]
+                         + coeffs[3] * d[2]) * gain;
+                  }
+            }
+      else {
+            float gl = _channel->panLeftGain();
+            float gr = _channel->panRightGain();
+            for (int i = 0; i < n; ++i) {
+                  int64_t ph          = pos + i * incr;
+                  const short* d      = src + ((ph - base) >> 8) * 2;
+                  const float* coeffs = interpCoeff[ph & 0xff];
+                  in1[i] = (coeffs[0] * d[-2]
+                         + coeffs[1] * d[0]
+                         + coeffs[2] * d[2]
+                         + coeffs[3] * d[4])
+                         * gain * gl * z->ccGain;
+                  in2[i] = (coeffs[0] * d[-1]
+                         + coeffs[1] * d[1]
+                         + coeffs[2] * d[3]
+                         + coeffs[3] * d[5])
+                         * gain * gr * z->ccGain;
+                  }
+            }
 
-                  updateEnvelopes();
-                  if (_state == VoiceState::OFF)
-                        break;
+      // envelope values, the block does not cross a stage
+      Envelope& e = envelopes[currentEnvelope];
+      if (_state == VoiceState::ATTACK || _state == VoiceState::STOP) {
+            for (int i = 0; i < n; ++i) {
+                  e.step();
+                  env[i] = e.val;
+                  }
+            }
+      else {
+            for (int i = 0; i < n; ++i)
+                  env[i] = e.val;
+            }
 
-                  f1 *= envelopes[currentEnvelope].val;
-                  f2 *= envelopes[currentEnvelope].val;
+      // the filter is recursive and processed frame by frame
+      if (audioChan == 1) {
+            float gl = _channel->panLeftGain();
+            float gr = _channel->panRightGain();
+            for (int i = 0; i < n; ++i) {
+                  float f = in1[i] - a1 * hist1l - a2 * hist2l;
+                  float v = b02 * (f + hist2l) + b1 * hist1l;
+                  hist2l  = hist1l;
+                  hist1l  = f;
+                  v *= env[i] * z->ccGain;
+                  *p++  += v * gl;
+                  *p++  += v * gr;
+                  }
+            }
+      else {
+            for (int i = 0; i < n; ++i) {
+                  float f1 = in1[i] * env[i];
+                  float f2 = in2[i] * env[i];
 
                   f1      += -a1 * hist1l - a2 * hist2l;
                   float vl = b02 * (f1 + hist2l) + b1 * hist1l;
@@ -414,20 +517,145 @@ void Voice::process(int frames, float* p)
                   hist2r   = hist1r;
                   hist1r   = f2;
 
-                  if (filter_coeff_incr_count) {
-                        --filter_coeff_incr_count;
-                        a1  += a1_incr;
-                        a2  += a2_incr;
-                        b02 += b02_incr;
-                        b1  += b1_incr;
-                        }
-
                   *p++  += vl;
                   *p++  += vr;
-                  phase += phaseIncr;
-                  _samplesSinceStart++;
                   }
             }
+      phase.data         += n * incr;
+      _samplesSinceStart += n;
+      if (_streaming)
+            _stream->setReadFrame(phase.index());
+      }
+
+//---------------------------------------------------------
+//   processFrame
+//    render one frame, return false if the voice has
+//    stopped
+//---------------------------------------------------------
+
+bool Voice::processFrame(float* p)
+      {
+      updateLoop();
+      if (_streaming)
+            updateStream(phase.index());
+
+      if (audioChan == 1) {
+            int idx = phase.index();
+
+            if (idx >= eidx) {
+                  off();
+                  return false;
+                  }
+            const float* coeffs = interpCoeff[phase.fract()];
+            float f;
+            f =  (coeffs[0] * getData(idx-1)
+                + coeffs[1] * getData(idx+0)
+                + coeffs[2] * getData(idx+1)
+                + coeffs[3] * getData(idx+2)) * gain
+                - a1 * hist1l
+                - a2 * hist2l;
+            float v = b02 * (f + hist2l) + b1 * hist1l;
+            hist2l  = hist1l;
+            hist1l  = f;
+
+            if (filter_coeff_incr_count) {
+                  --filter_coeff_incr_count;
+                  a1  += a1_incr;
+                  a2  += a2_incr;
+                  b02 += b02_incr;
+                  b1  += b1_incr;
+                  }
+
+            updateEnvelopes();
+            if (_state == VoiceState::OFF)
+                  return false;
+            v *= envelopes[currentEnvelope].val * z->ccGain;
+
+            *p++  += v * _channel->panLeftGain();
+            *p++  += v * _channel->panRightGain();
+            }
+      else {
+            //
+            // handle interleaved stereo samples
+            //
+            int idx = phase.index() * 2;
+            if (idx >= eidx) {
+                  off();
+                  // printf("end of sample\n");
+                  return false;
+                  }
+
+            const float* coeffs = interpCoeff[phase.fract()];
+            float f1, f2;
+
+            f1 = (coeffs[0] * getData(idx-2)
+                + coeffs[1] * getData(idx)
+                + coeffs[2] * getData(idx+2)
+                + coeffs[3] * getData(idx+4))
+                * gain * _channel->panLeftGain() * z->ccGain;
+
+            f2 = (coeffs[0] * getData(idx-1)
+                + coeffs[1] * getData(idx+1)
+                + coeffs[2] * getData(idx+3)
+                + coeffs[3] * getData(idx+5))
+                * gain * _channel->panRightGain() * z->ccGain;
+
+            updateEnvelopes();
+            if (_state == VoiceState::OFF)
+                  return false;
+
+            f1 *= envelopes[currentEnvelope].val;
+            f2 *= envelopes[currentEnvelope].val;
+
+            f1      += -a1 * hist1l - a2 * hist2l;
+            float vl = b02 * (f1 + hist2l) + b1 * hist1l;
+            hist2l   = hist1l;
+            hist1l   = f1;
+
+            f2      +=  -a1 * hist1r - a2 * hist2r;
+            float vr = b02 * (f2 + hist2r) + b1 * hist1r;
+            hist2r   = hist1r;
+            hist1r   = f2;
+
+            if (filter_coeff_incr_count) {
+                  --filter_coeff_incr_count;
+                  a1  += a1_incr;
+                  a2  += a2_incr;
+                  b02 += b02_incr;
+                  b1  += b1_incr;
+                  }
+
+            *p++  += vl;
+            *p++  += vr;
+            }
+      phase += phaseIncr;
+      _samplesSinceStart++;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   loopActive
+//---------------------------------------------------------
+
+bool Voice::loopActive() const
+      {
+      bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx/audioChan));
+      bool shallLoop = loopMode() == LoopMode::CONTINUOUS || (loopMode() == LoopMode::SUSTAIN && (_state < VoiceState::STOP));
+      return validLoop && shallLoop;
+      }
+
+//---------------------------------------------------------
+//   updateStream
+//    tell the streamer which frames are no longer needed
+//    and count the frames which are not read in time
+//---------------------------------------------------------
+
+void Voice::updateStream(int idx)
+      {
+      _stream->setReadFrame(idx);
+      int last = idx + 2;
+      if (last >= _streamStart && last < _streamEnd && last >= _stream->writeFrame())
+            _stream->underrun();
       }
 
 //---------------------------------------------------------
@@ -438,10 +666,8 @@ void Voice::updateLoop()
       {
       int idx = phase.index();
       int loopOffset = (audioChan * 3) - 1; // offset due to interpolation
-      bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx/audioChan));
-      bool shallLoop = loopMode() == LoopMode::CONTINUOUS || (loopMode() == LoopMode::SUSTAIN && (_state < VoiceState::STOP));
 
-      if (!(validLoop && shallLoop)) {
+      if (!loopActive()) {
             _looping = false;
             return;
             }
@@ -456,8 +682,11 @@ short Voice::getData(int pos) {
       if (pos < 0 && !_looping)
             return 0;
 
-      if (!_looping)
+      if (!_looping) {
+            if (_streaming && pos >= _streamStart * audioChan)
+                  return _stream->data(pos, audioChan);
             return data[pos];
+            }
 
       int loopEnd = _loopEnd * audioChan;
       int loopStart = _loopStart * audioChan;
@@ -20,6 +20,7 @@ class Channel;
 struct Zone;
 class Sample;
 class Zerberus;
+class StreamBuffer;
 
 enum class LoopMode : char;
 enum class OffMode : char;
@@ -27,6 +28,7 @@ enum class Trigger : char;
 
 static const int INTERP_MAX = 256;
 static const int EG_SIZE    = 256;
+static const int BLOCK_FRAMES = 64;     // max frames rendered by Voice::processBlock()
 
 //---------------------------------------------------------
 //   Envelope
@@ -130,6 +132,11 @@ class Voice {
       bool _looping;
       int _samplesSinceStart;
 
+      StreamBuffer* _stream = 0;
+      bool _streaming = false;      // playing a streamed sample
+      int _streamStart;             // first frame not in the sample head
+      int _streamEnd;
+
       float gain;
 
       Phase phase, phaseIncr;
@@ -169,6 +176,11 @@ class Voice {
       static float interpCoeff[INTERP_MAX][4];
 
       void updateFilter(float fres);
+      int blockFrames(int frames) const;
+      void processBlock(int n, float*);
+      bool processFrame(float*);
+      bool loopActive() const;
+      void updateStream(int idx);
 
       Trigger trigger;
 
@@ -178,6 +190,7 @@ class Voice {
       Voice(Zerberus*);
       Voice* next() const         { return _next; }
       void setNext(Voice* v)      { _next = v; }
+      void setStream(StreamBuffer* s) { _stream = s; }
 
       void start(Channel* channel, int key, int velo, const Zone*, double durSinceNoteOn);
       void updateEnvelopes();
@@ -196,7 +209,7 @@ class Voice {
       void stop()                 { envelopes[currentEnvelope].step(); envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val; currentEnvelope = V1Envelopes::RELEASE; _state = VoiceState::STOP;      }
       void stop(float time);
       void sustained()            { _state = VoiceState::SUSTAINED; }
-      void off()                  { _state = VoiceState::OFF;       }
+      void off();
       const char* state() const;
       LoopMode loopMode() const   { return _loopMode; }
       int getSamplesSinceStart()  { return _samplesSinceStart;    }
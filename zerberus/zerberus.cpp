@@ -20,6 +20,7 @@
 #include "channel.h"
 #include "instrument.h"
 #include "zone.h"
+#include "stream.h"
 
 #include <stdio.h>
 
@@ -47,8 +48,11 @@ Zerberus::Zerberus()
             initialized = true;
             Voice::init();
             }
-      for (int i = 0; i < MAX_VOICES; ++i)
-            freeVoices.push(new Voice(this));
+      for (int i = 0; i < MAX_VOICES; ++i) {
+            Voice* v = new Voice(this);
+            voices.push_back(v);
+            freeVoices.push(v);
+            }
       for (int i = 0; i < MAX_CHANNEL; ++i)
             _channel[i] = new Channel(this, i);
       busy = true;      // no sf loaded yet
@@ -61,6 +65,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
       {
       busy = true;
+      delete streamer;
       while (!instruments.empty()) {
             auto i  = instruments.front();
             auto it = instruments.begin();
@@ -217,10 +222,69 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
       {
       if (busy)
             return;
+      processPartition(0, 1, frames, p, 0, 0);
+      removeFinishedVoices();
+      }
+
+//---------------------------------------------------------
+//   processChannels
+//---------------------------------------------------------
+
+bool Zerberus::processChannels(unsigned frames, float** bus, int channels, float*, float*)
+      {
+      if (busy)
+            return false;
+      for (Voice* v = activeVoices; v; v = v->next()) {
+            int idx = v->channel()->idx();
+            if (idx < channels)
+                  v->process(frames, bus[idx]);
+            }
+      removeFinishedVoices();
+      return true;
+      }
+
+//---------------------------------------------------------
+//   beginPartitions
+//---------------------------------------------------------
+
+bool Zerberus::beginPartitions()
+      {
+      return !busy && activeVoices;
+      }
+
+//---------------------------------------------------------
+//   processPartition
+//    render every parts'th voice; the voices are
+//    independent, the voice list is not changed
+//---------------------------------------------------------
+
+void Zerberus::processPartition(int part, int parts, unsigned frames, float* p, float*, float*)
+      {
+      int i = 0;
+      for (Voice* v = activeVoices; v; v = v->next(), ++i) {
+            if (i % parts == part)
+                  v->process(frames, p);
+            }
+      }
+
+//---------------------------------------------------------
+//   endPartitions
+//---------------------------------------------------------
+
+void Zerberus::endPartitions()
+      {
+      removeFinishedVoices();
+      }
+
+//---------------------------------------------------------
+//   removeFinishedVoices
+//---------------------------------------------------------
+
+void Zerberus::removeFinishedVoices()
+      {
       Voice* v = activeVoices;
       Voice* pv = 0;
       while (v) {
-            v->process(frames, p);
             if (v->isOff()) {
                   if (pv)
                         pv->setNext(v->next());
@@ -414,6 +478,8 @@ bool Zerberus::loadInstrument(const QString& s)
             }
       for (ZInstrument* instr : globalInstruments) {
             if (QFileInfo(instr->path()).fileName() == fileName) {
+                  if (instr->streamed())
+                        startStreamer();
                   instruments.push_back(instr);
                   instr->setRefCount(instr->refCount() + 1);
                   if (instruments.size() == 1) {
@@ -438,6 +504,8 @@ bool Zerberus::loadInstrument(const QString& s)
 
       try {
             if (instr->load(path)) {
+                  if (instr->streamed())
+                        startStreamer();
                   globalInstruments.push_back(instr);
                   instruments.push_back(instr);
                   instr->setRefCount(1);
@@ -463,3 +531,56 @@ bool Zerberus::loadInstrument(const QString& s)
       return false;
       }
 
+//---------------------------------------------------------
+//   startStreamer
+//    start the reader thread for streamed samples; has to
+//    be called before a streamed instrument is used
+//---------------------------------------------------------
+
+void Zerberus::startStreamer()
+      {
+      if (streamer)
+            return;
+      streamer = new SampleStreamer;
+      for (Voice* v : voices)
+            v->setStream(streamer->addStream());
+      streamer->start(QThread::HighPriority);
+      }
+
+//---------------------------------------------------------
+//   streamUnderruns
+//    number of frames played as silence because streamed
+//    sample data were not read from disk in time
+//---------------------------------------------------------
+
+int Zerberus::streamUnderruns() const
+      {
+      return streamer ? streamer->underruns() : 0;
+      }
+
+void Zerberus::resetStreamUnderruns()
+      {
+      if (streamer)
+            streamer->resetUnderruns();
+      }
+
+//---------------------------------------------------------
+//   streamErrors
+//    number of streamed voices whose sample file could not
+//    be read
+//---------------------------------------------------------
+
+int Zerberus::streamErrors() const
+      {
+      return streamer ? streamer->errors() : 0;
+      }
+
+//---------------------------------------------------------
+//   streamReady
+//    the streamer has read the next frames of all voices
+//---------------------------------------------------------
+
+bool Zerberus::streamReady(int frames) const
+      {
+      return streamer ? streamer->ready(frames) : true;
+      }
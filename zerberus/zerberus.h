@@ -17,6 +17,7 @@
 #include <atomic>
 // #include <mutex>
 #include <list>
+#include <vector>
 
 #include "synthesizer/synthesizer.h"
 #include "synthesizer/event.h"
@@ -24,6 +25,7 @@
 
 class Channel;
 class ZInstrument;
+class SampleStreamer;
 enum class Trigger : char;
 
 static const int MAX_VOICES  = 512;
@@ -80,6 +82,8 @@ class Zerberus : public Ms::Synthesizer {
       int allocatedVoices = 0;
       VoiceFifo freeVoices;
       Voice* activeVoices = 0;
+      std::vector<Voice*> voices;         // all voices, owned by freeVoices
+      SampleStreamer* streamer = 0;
       int _loadProgress = 0;
       bool _loadWasCanceled = false;
 
@@ -87,12 +91,18 @@ class Zerberus : public Ms::Synthesizer {
       void trigger(Channel*, int key, int velo, Trigger, int cc, int ccVal, double durSinceNoteOn);
       void processNoteOff(Channel*, int pitch);
       void processNoteOn(Channel* cp, int key, int velo);
+      void removeFinishedVoices();
+      void startStreamer();
 
    public:
       Zerberus();
       ~Zerberus();
 
       virtual void process(unsigned frames, float*, float*, float*);
+      virtual bool beginPartitions();
+      virtual void processPartition(int part, int parts, unsigned frames, float*, float*, float*);
+      virtual void endPartitions();
+      virtual bool processChannels(unsigned frames, float** bus, int channels, float*, float*);
       virtual void play(const Ms::PlayEvent& event);
 
       bool loadInstrument(const QString&);
@@ -104,6 +114,10 @@ class Zerberus : public Ms::Synthesizer {
       void setLoadProgress(int val) { _loadProgress = val; }
       bool loadWasCanceled()        { return _loadWasCanceled; }
       void setLoadWasCanceled(bool status)     { _loadWasCanceled = status; }
+      int streamUnderruns() const;
+      void resetStreamUnderruns();
+      int streamErrors() const;
+      bool streamReady(int frames) const;
 
       virtual void setMasterTuning(double val) { _masterTuning = val;  }
       virtual double masterTuning() const      { return _masterTuning; }